@@ -0,0 +1,74 @@
+#include <Arduino.h>
+#include <U8g2lib.h>
+#include <pixelView.h>
+
+#define JOY_X 8
+#define JOY_Y 7
+#define BTN 6
+
+#define LEN(array) ((int)sizeof(array) / (int)sizeof((array)[0]))
+
+static const unsigned char image_Battery_low_bits[] = {0xfe, 0x1f, 0x02, 0x10, 0x03, 0x10, 0x03,
+                                                       0x10, 0x02, 0x10, 0xfe, 0x1f, 0x00, 0x00, 0x00, 0x00};
+static const unsigned char image_Battery_full_bits[] = {0xfe, 0x1f, 0xfe, 0x1f, 0xff, 0x1f, 0xff,
+                                                        0x1f, 0xfe, 0x1f, 0xfe, 0x1f, 0x00, 0x00, 0x00, 0x00};
+
+ActionType sendInput() {
+  int X = analogRead(JOY_X);
+  int Y = analogRead(JOY_Y);
+
+  if (X < 10 && Y > 1750) {
+    return ActionType::UP;
+  } else if (X > 3900 && Y > 1750) {
+    return ActionType::DOWN;
+  } else if (X > 1750 && Y < 50) {
+    return ActionType::LEFT;
+  } else if (X > 1750 && Y > 3900) {
+    return ActionType::RIGHT;
+  }
+
+  if (digitalRead(BTN) == LOW) return ActionType::SEL;
+
+  return ActionType::NONE;
+}
+
+U8G2_SH1106_128X64_NONAME_F_HW_I2C u8g2(U8G2_R0, /* reset=*/U8X8_PIN_NONE);
+PixelView pv(&u8g2, sendInput, delay, u8g2_font_haxrcorp4089_tr);
+
+// The values shown on the dashboard. Widgets read them through a pointer...
+float temperature = 21.0;
+int batteryLevel = 1;
+
+// ...or through a getter
+float readLoad() { return analogRead(JOY_X) * 100.0 / 4095; }
+
+// Each widget owns a region and only redraws (and sends) that region when what it shows changes
+PixelView::Readout tempReadout(&pv, {0, 0, 80, 12}, &temperature, 1, 0.05, "Temp", "C");
+PixelView::Readout loadReadout(&pv, {0, 14, 80, 12}, readLoad, 0, 1, "Load", "%");
+PixelView::Bar loadBar(&pv, {0, 28, 128, 10}, readLoad);
+PixelView::Sparkline tempHistory(&pv, {0, 40, 128, 24}, &temperature, 200);
+
+const unsigned char *batteryIcons[] = {image_Battery_low_bits, image_Battery_full_bits};
+PixelView::StatusIcon battery(&pv, {112, 0, 16, 8}, &batteryLevel, batteryIcons, LEN(batteryIcons));
+
+PixelView::BoundWidget *widgets[] = {&tempReadout, &loadReadout, &loadBar, &tempHistory, &battery};
+
+void setup() {
+  pinMode(JOY_X, INPUT);
+  pinMode(JOY_Y, INPUT);
+  pinMode(BTN, INPUT_PULLUP);
+
+  u8g2.begin();
+  u8g2.clearBuffer();
+  u8g2.sendBuffer();
+}
+
+void loop() {
+  temperature += (random(-10, 11)) / 100.0;
+  batteryLevel = (pv.doInput() == ActionType::SEL) ? 0 : 1;
+
+  // Cheap to call often: nothing is sent unless a value visibly changed
+  PixelView::BoundWidget::updateAll(widgets, LEN(widgets));
+
+  delay(10);
+}
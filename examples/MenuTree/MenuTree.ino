@@ -0,0 +1,74 @@
+#include <Arduino.h>
+#include <U8g2lib.h>
+#include <pixelView.h>
+
+#define JOY_X 8
+#define JOY_Y 7
+#define BTN 6
+
+ActionType sendInput() {
+  int X = analogRead(JOY_X);
+  int Y = analogRead(JOY_Y);
+
+  if (X < 10 && Y > 1750) {
+    return ActionType::UP;
+  } else if (X > 3900 && Y > 1750) {
+    return ActionType::DOWN;
+  } else if (X > 1750 && Y < 50) {
+    return ActionType::LEFT;
+  } else if (X > 1750 && Y > 3900) {
+    return ActionType::RIGHT;
+  }
+
+  if (digitalRead(BTN) == LOW) return ActionType::SEL;
+
+  return ActionType::NONE;
+}
+
+U8G2_SH1106_128X64_NONAME_F_HW_I2C u8g2(U8G2_R0, /* reset=*/U8X8_PIN_NONE);
+PixelView pv(&u8g2, sendInput, delay, u8g2_font_haxrcorp4089_tr);
+
+const unsigned char bmpDisplay[] PROGMEM = {0x00, 0x00, 0xfe, 0x7f, 0x02, 0x40, 0x02, 0x40, 0x02, 0x40, 0x02,
+                                            0x40, 0x02, 0x40, 0x02, 0x40, 0x02, 0x40, 0x02, 0x40, 0xfe, 0x7f,
+                                            0x80, 0x01, 0x80, 0x01, 0xf0, 0x0f, 0x00, 0x00, 0x00, 0x00};
+const unsigned char bmpInfo[] PROGMEM = {0x00, 0x00, 0xe0, 0x07, 0x18, 0x18, 0x84, 0x21, 0x84, 0x21, 0x02,
+                                         0x40, 0x82, 0x41, 0x82, 0x41, 0x82, 0x41, 0x82, 0x41, 0x84, 0x21,
+                                         0x84, 0x21, 0x18, 0x18, 0xe0, 0x07, 0x00, 0x00, 0x00, 0x00};
+
+uint8_t contrast = 255;
+bool flipped = false;
+
+void brighter() { u8g2.setContrast(contrast = contrast > 205 ? 255 : contrast + 50); }
+void dimmer() { u8g2.setContrast(contrast = contrast < 50 ? 0 : contrast - 50); }
+void flip() { u8g2.setFlipMode(flipped = !flipped); }
+void about() { pv.showMessage("PixelView menu tree demo"); }
+void resetSettings() {
+  if (!pv.confirmYN("Reset display settings?")) return;
+  u8g2.setContrast(contrast = 255);
+  u8g2.setFlipMode(flipped = false);
+}
+
+// The whole tree is built by the compiler and lives in flash. Declare it from the leaves up
+constexpr MenuNode contrastItems[] = {menuAction("Brighter", brighter), menuAction("Dimmer", dimmer)};
+constexpr MenuNode displayItems[] = {menuNode("Contrast", contrastItems), menuAction("Flip", flip)};
+constexpr MenuNode systemItems[] = {menuAction("Reset", resetSettings), menuAction("Do nothing", NULL)};
+constexpr MenuNode mainItems[] = {menuNode("Display", displayItems, bmpDisplay),
+                                  menuNode("System", systemItems, bmpInfo), menuAction("About", about, bmpInfo)};
+constexpr MenuNode mainMenu = menuNode("Main", mainItems);
+
+// A stack of menuDepth(mainMenu) = 3 levels remembers the path and the selection in each menu
+PixelView::MenuNavigator<menuDepth(mainMenu)> nav(&pv, mainMenu);
+
+void setup() {
+  pinMode(JOY_X, INPUT);
+  pinMode(JOY_Y, INPUT);
+  pinMode(BTN, INPUT_PULLUP);
+
+  u8g2.begin();
+}
+
+void loop() {
+  // Returns after an action ran, back in the menu it was picked from on the next call
+  const MenuNode *picked = nav.select();
+  if (picked == NULL) pv.showMessage("Left the main menu");
+}
@@ -164,7 +164,14 @@ void mockApp(PixelView *pv) {
 
   // Array of pages, each page has a 'enabled' property (set 'true' for every page here)
   // You can change it runtime
-  Page functions[] = {{true, homePage}, {true, summary}, {true, logs}, {true, src}, {true, exit}};
+  // Pages that don't change on their own are STATIC, so the Pager only redraws them on input.
+  // 'logs' stays ANIMATED so the page is drawn again after the list browser returns
+  using Refresh = PixelView::Pager::Refresh;
+  Page functions[] = {{true, homePage, Refresh::STATIC},
+                      {true, summary, Refresh::STATIC},
+                      {true, logs},
+                      {true, src},
+                      {true, exit, Refresh::STATIC}};
 
   PixelView::Pager p(pv, LEN(functions), functions, PixelView::Pager::IndicatorType::DOT);
 
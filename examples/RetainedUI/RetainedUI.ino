@@ -0,0 +1,124 @@
+#include <Arduino.h>
+#include <U8g2lib.h>
+#include <pixelView.h>
+
+#define JOY_X 8
+#define JOY_Y 7
+#define BTN 6
+
+#define LEN(array) ((int)sizeof(array) / (int)sizeof((array)[0]))
+
+ActionType sendInput() {
+  int X = analogRead(JOY_X);
+  int Y = analogRead(JOY_Y);
+
+  if (X < 10 && Y > 1750) {
+    return ActionType::UP;
+  } else if (X > 3900 && Y > 1750) {
+    return ActionType::DOWN;
+  }
+
+  if (digitalRead(BTN) == LOW) return ActionType::SEL;
+
+  return ActionType::NONE;
+}
+
+U8G2_SH1106_128X64_NONAME_F_HW_I2C u8g2(U8G2_R0, /* reset=*/U8X8_PIN_NONE);
+PixelView pv(&u8g2, sendInput, delay, u8g2_font_haxrcorp4089_tr);
+
+// A custom node: a checkbox row that can be focused
+class Toggle : public PixelView::Node {
+public:
+  Toggle(const char *name) : name(name) {}
+
+  void setChecked(bool c) {
+    if (c != checked) {
+      checked = c;
+      invalidate();
+    }
+  }
+  bool isChecked() const { return checked; }
+
+  void setFocused(bool f) {
+    if (f != focused) {
+      focused = f;
+      invalidate();
+    }
+  }
+
+  Size measure(U8G2 *, Size available) override { return {available.w, 12}; }
+
+protected:
+  void draw(U8G2 *disp) override {
+    disp->drawFrame(bounds.x + 2, bounds.y + 2, 8, 8);
+    if (checked) disp->drawBox(bounds.x + 4, bounds.y + 4, 4, 4);
+    disp->drawStr(bounds.x + 14, bounds.y + 10, name);
+    if (focused) disp->drawFrame(bounds.x, bounds.y, bounds.w, bounds.h);
+  }
+
+private:
+  const char *name;
+  bool checked = false;
+  bool focused = false;
+};
+
+// Status bar: uptime on the left, number of enabled toggles on the right
+PixelView::Label uptime("0s");
+PixelView::Label enabled("0/3", NULL, PixelView::Label::Align::RIGHT);
+PixelView::Node *barItems[] = {&uptime, &enabled};
+PixelView::Container bar(barItems, LEN(barItems), PixelView::Container::Direction::HORIZONTAL);
+
+Toggle toggles[] = {Toggle("Wi-Fi"), Toggle("Bluetooth"), Toggle("Logging")};
+PixelView::Node *toggleItems[] = {&toggles[0], &toggles[1], &toggles[2]};
+PixelView::Container list(toggleItems, LEN(toggleItems), PixelView::Container::Direction::VERTICAL, 2);
+
+PixelView::Node *rootItems[] = {&bar, &list};
+PixelView::Container root(rootItems, LEN(rootItems), PixelView::Container::Direction::VERTICAL, 4);
+
+PixelView::Scene scene(&pv, &root);
+int focus = 0;
+
+void setup() {
+  pinMode(JOY_X, INPUT);
+  pinMode(JOY_Y, INPUT);
+  pinMode(BTN, INPUT_PULLUP);
+  Serial.begin(115200);
+
+  u8g2.begin();
+  toggles[focus].setFocused(true);
+  scene.render(); // First render draws and sends everything
+}
+
+void loop() {
+  switch (pv.doInput()) {
+  case ActionType::UP:
+  case ActionType::DOWN:
+    toggles[focus].setFocused(false);
+    focus = (focus + 1) % LEN(toggles);
+    toggles[focus].setFocused(true);
+    break;
+  case ActionType::SEL: {
+    toggles[focus].setChecked(!toggles[focus].isChecked());
+    int count = 0;
+    for (Toggle &t : toggles) count += t.isChecked();
+    char text[8];
+    snprintf(text, sizeof(text), "%d/%d", count, LEN(toggles));
+    enabled.setText(text);
+    break;
+  }
+  default:
+    break;
+  }
+
+  char text[12];
+  snprintf(text, sizeof(text), "%lus", millis() / 1000);
+  uptime.setText(text); // Only invalidates once a second, when the text changes
+
+  // Nothing is drawn or sent unless a node was invalidated
+  if (scene.render()) {
+    Serial.printf("Sent %dx%d at %d,%d, %u nodes drawn\n", scene.lastRegion.w, scene.lastRegion.h, scene.lastRegion.x,
+                  scene.lastRegion.y, (unsigned)scene.lastDrawn);
+  }
+
+  delay(10);
+}
@@ -58,14 +58,11 @@ PixelView::Keyboard keyboard(&pixelview);
 void wifiScanner(PixelView *pv, PixelView::Keyboard *kyb, U8G2 *u8g2) {
   WiFi.mode(WIFI_STA);
 
-  // There's a bug with the WiFi library on the ESP32 where Async scan errors out... if it is fixed we can use progressCircle() while waiting for the scan to finish :)
-
-  u8g2->clearBuffer();
-  u8g2->setFont(u8g2_font_haxrcorp4089_tr);
-  u8g2->drawStr(0, 10, "Scanning Wi-Fi networks...");
-  u8g2->sendBuffer();
-
+  // scanNetworks() blocks for a few seconds: the spinner keeps turning from its own task meanwhile
+  PixelView::Spinner spinner(pv);
+  spinner.start("Scanning Wi-Fi...");
   const int n = WiFi.scanNetworks();
+  spinner.stop();
 
   if (n == 0) {
     Serial.println("No networks found");
@@ -102,12 +99,11 @@ void wifiScanner(PixelView *pv, PixelView::Keyboard *kyb, U8G2 *u8g2) {
   WiFi.begin(ssid, psk);
 
   int beginMS = millis();
-  byte b = 0;
+  spinner.start("Connecting...");
   while (WiFi.status() != WL_CONNECTED && millis() - beginMS < TIMEOUT) {
-    pv->progressCircle(b);
-    b++;
-    vTaskDelay(70 / portTICK_PERIOD_MS);
+    vTaskDelay(100 / portTICK_PERIOD_MS);
   }
+  spinner.stop();
 
   if (WiFi.status() == WL_CONNECTED) pv->showMessage(("Connected successfully to: " + ssid).c_str());
   else pv->showMessage("Failed to connect");
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <new>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @class BitSet
+ * @brief A fixed number of bits, packed 32 to a word. Storage is allocated once, on construction.
+ *
+ * Keeps the number of bits set up to date, so count() is free. Bulk operations work a word at a time: checking
+ * 2000 items is 63 word writes.
+ *
+ * If the storage can't be allocated, valid() is false and the set is empty: size() is 0.
+ */
+class BitSet {
+public:
+  explicit BitSet(size_t size)
+      : words(new (std::nothrow) uint32_t[wordsFor(size)]()), bits(words != NULL ? size : 0) {}
+  BitSet(const BitSet &) = delete;
+  BitSet &operator=(const BitSet &) = delete;
+  ~BitSet() { delete[] words; }
+
+  /**
+   * @brief false if the storage couldn't be allocated
+   */
+  bool valid() const { return words != NULL; }
+
+  size_t size() const { return bits; }
+
+  /**
+   * @brief Number of bits set
+   */
+  size_t count() const { return setBits; }
+
+  bool test(size_t index) const { return words[index / 32] & bit(index); }
+
+  void set(size_t index, bool value = true) {
+    if (test(index) == value) return;
+    words[index / 32] ^= bit(index);
+    if (value) setBits++;
+    else setBits--;
+  }
+
+  void flip(size_t index) { set(index, !test(index)); }
+
+  void setAll(bool value = true) { setRange(0, bits, value); }
+
+  void flipAll() {
+    if (words == NULL) return;
+    for (size_t i = 0; i < wordsFor(bits); i++)
+      words[i] = ~words[i];
+    clearPadding();
+    setBits = bits - setBits;
+  }
+
+  /**
+   * @brief Sets bits first..last - 1 to `value`. An empty or reversed range does nothing
+   */
+  void setRange(size_t first, size_t last, bool value = true) {
+    if (last > bits) last = bits;
+    if (first >= last) return;
+    while (first < last && first % 32 != 0)
+      set(first++, value);
+    while (last - first >= 32) {
+      uint32_t &word = words[first / 32];
+      setBits -= popcount(word);
+      if (value) setBits += 32;
+      word = value ? 0xFFFFFFFFu : 0;
+      first += 32;
+    }
+    while (first < last)
+      set(first++, value);
+  }
+
+  /**
+   * @brief The packed words, bit i of the set being bit i % 32 of word i / 32. E.g. to save them
+   */
+  const uint32_t *data() const { return words; }
+  size_t dataWords() const { return words != NULL ? wordsFor(bits) : 0; }
+
+private:
+  uint32_t *words;
+  size_t bits;
+  size_t setBits = 0;
+
+  static size_t wordsFor(size_t bits) { return bits > 32 ? bits / 32 + (bits % 32 != 0) : 1; }
+  static uint32_t bit(size_t index) { return 1u << (index % 32); }
+
+  static unsigned popcount(uint32_t word) {
+    unsigned n = 0;
+    for (; word; word &= word - 1)
+      n++;
+    return n;
+  }
+
+  // Keeps the unused bits of the last word clear, so whole-word operations can ignore them
+  void clearPadding() {
+    if (bits % 32 != 0) words[bits / 32] &= (1u << (bits % 32)) - 1;
+  }
+};
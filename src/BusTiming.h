@@ -0,0 +1,67 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @struct BusTiming
+ * @brief How long sending part of the frame takes on an SH1106/SSD1306 bus, following the bytes U8G2 sends
+ *
+ * U8G2 sends the frame one 8 pixel high row of tiles at a time: 3 command bytes (page, column high, column
+ * low), then 8 data bytes per tile. Over I2C every command is a transaction of its own and data goes in
+ * transactions of up to 24 bytes, each with a start and stop condition, the address byte and a control byte,
+ * and 9 bits per byte (8 + ACK). Over SPI every byte is 8 clocks.
+ *
+ * | Bus           | Full 128x64 frame |
+ * | ------------- | ----------------- |
+ * | I2C 100 kHz   | 109 ms            |
+ * | I2C 400 kHz   | 27 ms             |
+ * | I2C 1 MHz     | 11 ms             |
+ * | SPI 8 MHz     | 1 ms              |
+ */
+struct BusTiming {
+  enum class Type { NONE, I2C, SPI };
+
+  Type type = Type::NONE;
+  unsigned long hz = 0;
+  uint8_t bytesPerTransaction = 24; // I2C data bytes per transaction
+
+  static BusTiming i2c(unsigned long hz) {
+    BusTiming t;
+    t.type = Type::I2C;
+    t.hz = hz;
+    return t;
+  }
+
+  static BusTiming spi(unsigned long hz) {
+    BusTiming t;
+    t.type = Type::SPI;
+    t.hz = hz;
+    return t;
+  }
+
+  bool enabled() const { return type != Type::NONE && hz != 0; }
+
+  /**
+   * @brief Bus clocks to send `tw` x `th` tiles
+   */
+  unsigned long long bitsFor(uint8_t tw, uint8_t th) const {
+    const unsigned long long data = (unsigned long long)tw * 8;
+    unsigned long long perRow;
+    if (type == Type::I2C) {
+      const unsigned long long overhead = 2 + 9 + 9; // Start and stop, address byte, control byte
+      unsigned long long transactions = (data + bytesPerTransaction - 1) / bytesPerTransaction;
+      perRow = 3 * (overhead + 9) + transactions * overhead + data * 9;
+    } else {
+      perRow = (3 + data) * 8;
+    }
+    return perRow * th;
+  }
+
+  /**
+   * @brief Microseconds to send `tw` x `th` tiles, 0 if no bus is set
+   */
+  unsigned long transferMicros(uint8_t tw, uint8_t th) const {
+    if (!enabled() || tw == 0 || th == 0) return 0;
+    return (unsigned long)(bitsFor(tw, th) * 1000000ULL / hz);
+  }
+};
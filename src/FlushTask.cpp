@@ -0,0 +1,166 @@
+#include "FlushTask.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef ARDUINO
+#include <chrono>
+#endif
+
+FlushTask::FlushTask(U8G2 *display) : u8g2(display) {}
+
+FlushTask::~FlushTask() {
+  if (buffer == NULL) return;
+
+  wait();
+
+#if defined(PIXELVIEW_FLUSH_FREERTOS)
+  stopping = true;
+  xSemaphoreGive(work);
+  xSemaphoreTake(idle, portMAX_DELAY); // The task gives it back one last time before deleting itself
+  vSemaphoreDelete(work);
+  vSemaphoreDelete(idle);
+#elif defined(PIXELVIEW_FLUSH_THREAD)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  changed.notify_all();
+  thread.join();
+#endif
+
+  free(buffer);
+}
+
+bool FlushTask::begin() {
+  if (buffer != NULL) return true;
+  if (u8g2->getBufferTileHeight() * 8 < u8g2->getDisplayHeight()) return false;
+
+  bufferSize = (size_t)u8g2->getBufferTileWidth() * u8g2->getBufferTileHeight() * 8;
+  buffer = (uint8_t *)malloc(bufferSize);
+  if (buffer == NULL) return false;
+
+#if defined(PIXELVIEW_FLUSH_FREERTOS)
+  work = xSemaphoreCreateBinary();
+  idle = xSemaphoreCreateBinary();
+  if (work == NULL || idle == NULL ||
+      xTaskCreate(taskMain, "pixelViewFlush", 2048, this, uxTaskPriorityGet(NULL), &task) != pdPASS) {
+    if (work != NULL) vSemaphoreDelete(work);
+    if (idle != NULL) vSemaphoreDelete(idle);
+    free(buffer);
+    buffer = NULL;
+    return false;
+  }
+  xSemaphoreGive(idle);
+#elif defined(PIXELVIEW_FLUSH_THREAD)
+  thread = std::thread(&FlushTask::threadMain, this);
+#endif
+  return true;
+}
+
+void FlushTask::submitFrame() { submit(0, 0, u8g2->getBufferTileWidth(), u8g2->getBufferTileHeight()); }
+
+void FlushTask::submit(uint8_t tx, uint8_t ty, uint8_t tw, uint8_t th) {
+  if (buffer == NULL) {
+    u8g2->updateDisplayArea(tx, ty, tw, th);
+    return;
+  }
+
+#if defined(PIXELVIEW_FLUSH_FREERTOS)
+  xSemaphoreTake(idle, portMAX_DELAY);
+  snapshot(tx, ty, tw, th);
+  pending = true;
+  xSemaphoreGive(work);
+#elif defined(PIXELVIEW_FLUSH_THREAD)
+  std::unique_lock<std::mutex> lock(mutex);
+  changed.wait(lock, [this] { return !pending; });
+  snapshot(tx, ty, tw, th);
+  pending = true;
+  lock.unlock();
+  changed.notify_all();
+#else
+  snapshot(tx, ty, tw, th);
+  send();
+  transfers++;
+#endif
+}
+
+void FlushTask::snapshot(uint8_t tx, uint8_t ty, uint8_t tw, uint8_t th) {
+  memcpy(buffer, u8g2->getBufferPtr(), bufferSize);
+  this->tx = tx;
+  this->ty = ty;
+  this->tw = tw;
+  this->th = th;
+}
+
+void FlushTask::wait() {
+  if (buffer == NULL) return;
+
+#if defined(PIXELVIEW_FLUSH_FREERTOS)
+  xSemaphoreTake(idle, portMAX_DELAY);
+  xSemaphoreGive(idle);
+#elif defined(PIXELVIEW_FLUSH_THREAD)
+  std::unique_lock<std::mutex> lock(mutex);
+  changed.wait(lock, [this] { return !pending; });
+#endif
+}
+
+bool FlushTask::busy() {
+#if defined(PIXELVIEW_FLUSH_FREERTOS)
+  return pending;
+#elif defined(PIXELVIEW_FLUSH_THREAD)
+  std::lock_guard<std::mutex> lock(mutex);
+  return pending;
+#else
+  return false;
+#endif
+}
+
+void FlushTask::send() {
+#ifndef ARDUINO
+  auto end = std::chrono::steady_clock::now() + std::chrono::microseconds(simulatedBus.transferMicros(tw, th));
+#endif
+
+  // Same as updateDisplayArea(), but from the snapshot instead of the buffer being drawn into
+  u8x8_t *u8x8 = u8g2->getU8x8();
+  size_t rowBytes = (size_t)u8g2->getBufferTileWidth() * 8;
+  for (uint8_t row = ty; row < ty + th; row++)
+    u8x8_DrawTile(u8x8, tx, row, tw, buffer + row * rowBytes + tx * 8);
+  u8x8_RefreshDisplay(u8x8);
+
+#ifndef ARDUINO
+  std::this_thread::sleep_until(end);
+#endif
+}
+
+#if defined(PIXELVIEW_FLUSH_FREERTOS)
+void FlushTask::taskMain(void *self) {
+  FlushTask *flusher = static_cast<FlushTask *>(self);
+  while (true) {
+    xSemaphoreTake(flusher->work, portMAX_DELAY);
+    if (flusher->stopping) break;
+    flusher->send();
+    flusher->transfers++;
+    flusher->pending = false;
+    xSemaphoreGive(flusher->idle);
+  }
+  xSemaphoreGive(flusher->idle);
+  vTaskDelete(NULL);
+}
+#elif defined(PIXELVIEW_FLUSH_THREAD)
+void FlushTask::threadMain() {
+  std::unique_lock<std::mutex> lock(mutex);
+  while (true) {
+    changed.wait(lock, [this] { return pending || stopping; });
+    if (stopping) break;
+
+    // The snapshot is only touched again by submit() once pending is cleared, so the bus can run unlocked
+    lock.unlock();
+    send();
+    lock.lock();
+    transfers++;
+    pending = false;
+    changed.notify_all();
+  }
+}
+#endif
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "BusTiming.h"
+#include <U8g2lib.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(ESP32)
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#define PIXELVIEW_FLUSH_FREERTOS
+#elif !defined(ARDUINO)
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#define PIXELVIEW_FLUSH_THREAD
+#endif
+
+/**
+ * @class FlushTask
+ * @brief Sends frames to the display from a background task (a FreeRTOS task on ESP32, a std::thread on the host)
+ *
+ * submit() copies the drawn frame into a second buffer and returns immediately, so the caller can draw the next
+ * frame and sample input while the previous one is still on the bus. Only one frame is in flight: submit()
+ * first waits for the previous transfer to end, so frames are never torn or dropped. Anything else talking to
+ * the display (sendBuffer(), setContrast(), ...) must call wait() first.
+ *
+ * On platforms without threads (e.g. AVR) frames are sent synchronously.
+ *
+ * @note Only works with full buffer (_F_) U8G2 constructors
+ */
+class FlushTask {
+public:
+  explicit FlushTask(U8G2 *display);
+  FlushTask(const FlushTask &) = delete;
+  FlushTask &operator=(const FlushTask &) = delete;
+  ~FlushTask();
+
+  /**
+   * @brief Allocates the transfer buffer and starts the task
+   * @return false if the display has no full frame buffer or the buffer/task couldn't be created
+   */
+  bool begin();
+
+  /**
+   * @brief Queues the tiles tx..tx+tw, ty..ty+th of the current U8G2 buffer to be sent
+   */
+  void submit(uint8_t tx, uint8_t ty, uint8_t tw, uint8_t th);
+
+  /**
+   * @brief Queues the whole frame, like sendBuffer()
+   */
+  void submitFrame();
+
+  /**
+   * @brief Fence: returns once every submitted frame has been sent
+   */
+  void wait();
+
+  /**
+   * @brief true while a frame is being sent
+   */
+  bool busy();
+
+  /**
+   * @brief Number of transfers completed so far. Read it after wait()
+   */
+  unsigned long transfers = 0;
+
+#ifndef ARDUINO
+  /**
+   * @brief Host only: makes every transfer take as long as it would on this bus. By default transfers go as fast
+   *        as the U8G2 backend allows. Set it through PixelView::setBusTiming()
+   */
+  BusTiming simulatedBus;
+#endif
+
+private:
+  U8G2 *u8g2;
+  uint8_t *buffer = NULL;
+  size_t bufferSize = 0;
+
+  // The area waiting to be sent, in tiles
+  uint8_t tx = 0, ty = 0, tw = 0, th = 0;
+  volatile bool pending = false;
+  volatile bool stopping = false;
+
+  void snapshot(uint8_t tx, uint8_t ty, uint8_t tw, uint8_t th);
+  void send();
+
+#if defined(PIXELVIEW_FLUSH_FREERTOS)
+  TaskHandle_t task = NULL;
+  SemaphoreHandle_t work = NULL; // Given by submit(), taken by the task
+  SemaphoreHandle_t idle = NULL; // Held by the task while a transfer is in flight
+  static void taskMain(void *self);
+#elif defined(PIXELVIEW_FLUSH_THREAD)
+  std::thread thread;
+  std::mutex mutex;
+  std::condition_variable changed;
+  void threadMain();
+#endif
+};
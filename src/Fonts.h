@@ -0,0 +1,60 @@
+#pragma once
+
+#include <U8g2lib.h>
+
+// tools/fontsubset.py writes FontsSubset.h/.cpp next to this file with fonts holding only the glyphs PixelView
+// and your sketch draw. When present, its PIXELVIEW_FONT_* defines replace the stock U8G2 fonts below.
+#if defined(__has_include)
+#if __has_include("FontsSubset.h")
+#include "FontsSubset.h"
+#endif
+#endif
+
+#ifndef PIXELVIEW_FONT_TITLE
+#define PIXELVIEW_FONT_TITLE u8g2_font_helvB08_tr
+#endif
+#ifndef PIXELVIEW_FONT_BODY
+#define PIXELVIEW_FONT_BODY u8g2_font_helvR08_tr
+#endif
+#ifndef PIXELVIEW_FONT_SMALL
+#define PIXELVIEW_FONT_SMALL u8g2_font_haxrcorp4089_tr
+#endif
+#ifndef PIXELVIEW_FONT_MONO
+#define PIXELVIEW_FONT_MONO u8g2_font_6x12_tr
+#endif
+#ifndef PIXELVIEW_FONT_KEYS
+#define PIXELVIEW_FONT_KEYS u8g2_font_6x13_me
+#endif
+#ifndef PIXELVIEW_FONT_KEY_SYMBOLS
+#define PIXELVIEW_FONT_KEY_SYMBOLS u8g2_font_6x12_t_symbols
+#endif
+#ifndef PIXELVIEW_FONT_NUMPAD
+#define PIXELVIEW_FONT_NUMPAD u8g2_font_profont12_tf
+#endif
+#ifndef PIXELVIEW_FONT_DOTS
+#define PIXELVIEW_FONT_DOTS u8g2_font_unifont_t_75
+#endif
+
+/**
+ * @struct FontSet
+ * @brief Every font PixelView draws with, by role. Widgets only use the fonts in PixelView::fonts, so
+ *        swapping one here restyles every widget using that role
+ *
+ * The defaults are the PIXELVIEW_FONT_* macros, so fonts replaced at build time (by defining the macros or with
+ * tools/fontsubset.py) are the only ones linked in.
+ */
+struct FontSet {
+  const uint8_t *title;      // Menu, list and checkbox headers
+  const uint8_t *body;       // Menu and list items
+  const uint8_t *small;      // Numpad text, list entries, Readout
+  const uint8_t *mono;       // Default text font (PixelView's constructor argument), Pager numbers, keyboard preview
+  const uint8_t *keys;       // Keyboard keys
+  const uint8_t *keySymbols; // Keyboard special keys: ⇑ ⇐ # ¬ ✓ ✕ © ← →
+  const uint8_t *numpad;     // Numpad keys
+  const uint8_t *dots;       // Pager dots: ● ○
+
+  FontSet()
+      : title(PIXELVIEW_FONT_TITLE), body(PIXELVIEW_FONT_BODY), small(PIXELVIEW_FONT_SMALL), mono(PIXELVIEW_FONT_MONO),
+        keys(PIXELVIEW_FONT_KEYS), keySymbols(PIXELVIEW_FONT_KEY_SYMBOLS), numpad(PIXELVIEW_FONT_NUMPAD),
+        dots(PIXELVIEW_FONT_DOTS) {}
+};
@@ -0,0 +1,153 @@
+#include "FrameMirror.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static const uint8_t BLANK_TILE[8] = {0};
+
+FrameMirror::FrameMirror(WriteFuncType write, unsigned long keyframeEvery)
+    : write(write), keyframeEvery(keyframeEvery) {}
+
+FrameMirror::~FrameMirror() { free(shadow); }
+
+bool FrameMirror::begin(uint8_t tilesWide, uint8_t tilesHigh) {
+  free(shadow);
+  shadow = (uint8_t *)calloc((size_t)tilesWide * tilesHigh, 8);
+  this->tilesWide = shadow != NULL ? tilesWide : 0;
+  this->tilesHigh = shadow != NULL ? tilesHigh : 0;
+  keyframe = true;
+  return shadow != NULL;
+}
+
+size_t FrameMirror::encodedSize(const uint8_t *tile, const uint8_t *old) {
+  uint8_t mask = 0;
+  bool solid = true;
+  for (int i = 0; i < 8; i++) {
+    if (tile[i] != old[i]) mask |= 1 << i;
+    solid &= tile[i] == tile[0];
+  }
+  size_t bytes = 1;
+  for (uint8_t m = mask; m; m &= m - 1) bytes++;
+  return solid && bytes > 2 ? 2 : bytes;
+}
+
+void FrameMirror::emit(uint8_t byte) {
+  out[outLength++] = byte;
+  if (outLength == sizeof(out)) drain();
+}
+
+void FrameMirror::drain() {
+  if (outLength == 0) return;
+  write(out, outLength);
+  bytesSent += outLength;
+  outLength = 0;
+}
+
+void FrameMirror::emitTile(const uint8_t *tile, const uint8_t *old) {
+  size_t size = encodedSize(tile, old);
+  uint8_t mask = 0;
+  for (int i = 0; i < 8; i++)
+    if (tile[i] != old[i]) mask |= 1 << i;
+
+  // A fill is only used when it's shorter, so a tile with a single changed byte keeps its XOR form
+  if (size == 2 && mask != 0 && (mask & (mask - 1)) != 0) {
+    emit(0);
+    emit(tile[0]);
+    checksum += tile[0];
+    return;
+  }
+  emit(mask);
+  checksum += mask;
+  for (int i = 0; i < 8; i++) {
+    if (mask & (1 << i)) {
+      emit(tile[i] ^ old[i]);
+      checksum += tile[i] ^ old[i];
+    }
+  }
+}
+
+void FrameMirror::update(const uint8_t *rows, size_t rowBytes, uint8_t tx, uint8_t ty, uint8_t tw, uint8_t th) {
+  if (shadow == NULL) return;
+  if (tx + tw > tilesWide) tw = tx < tilesWide ? tilesWide - tx : 0;
+  if (ty + th > tilesHigh) th = ty < tilesHigh ? tilesHigh - ty : 0;
+
+  const size_t shadowRow = (size_t)tilesWide * 8;
+  if (keyframeEvery != 0 && packets % keyframeEvery == keyframeEvery - 1) keyframe = true;
+
+  // A keyframe sends the whole screen against a blank one: take in the new tiles, then send the copy
+  const uint8_t *source = rows;
+  size_t sourceRow = rowBytes;
+  if (keyframe) {
+    for (uint8_t r = 0; r < th; r++)
+      memcpy(shadow + (ty + r) * shadowRow + tx * 8, rows + r * rowBytes + tx * 8, tw * 8);
+    source = shadow;
+    sourceRow = shadowRow;
+    tx = ty = 0;
+    tw = tilesWide;
+    th = tilesHigh;
+  }
+
+  auto tileAt = [&](uint8_t col, uint8_t row) { return source + (size_t)row * sourceRow + col * 8; };
+  auto oldAt = [&](uint8_t col, uint8_t row) {
+    return keyframe ? BLANK_TILE : (const uint8_t *)shadow + (ty + row) * shadowRow + col * 8;
+  };
+
+  // First pass: the payload's size, so it can go out in small chunks after the header
+  size_t payload = 2;
+  for (uint8_t r = 0; r < th; r++) {
+    int lastIndex = -2, runLength = 0; // Runs end with the row, as below
+    for (uint8_t c = tx; c < tx + tw; c++) {
+      const uint8_t *tile = tileAt(c, r), *old = oldAt(c, r);
+      if (memcmp(tile, old, 8) == 0) continue;
+      int index = (ty + r) * tilesWide + c;
+      if (index != lastIndex + 1 || runLength == 255) {
+        payload += 3;
+        runLength = 0;
+      }
+      payload += encodedSize(tile, old);
+      lastIndex = index;
+      runLength++;
+    }
+  }
+  if (payload == 2 && !keyframe) return; // Nothing changed
+
+  emit(0xFE);
+  emit('P');
+  emit(keyframe ? 'K' : 'D');
+  emit(payload & 0xFF);
+  emit(payload >> 8);
+  checksum = tilesWide + tilesHigh;
+  emit(tilesWide);
+  emit(tilesHigh);
+
+  // Second pass: the runs, updating the copy as tiles go out. A run's length is known once it ends, so each
+  // run is measured before it's sent
+  for (uint8_t r = 0; r < th; r++) {
+    uint8_t c = tx;
+    while (c < tx + tw) {
+      if (memcmp(tileAt(c, r), oldAt(c, r), 8) == 0) {
+        c++;
+        continue;
+      }
+      uint8_t count = 0;
+      while (c + count < tx + tw && count < 255 && memcmp(tileAt(c + count, r), oldAt(c + count, r), 8) != 0)
+        count++;
+
+      int index = (ty + r) * tilesWide + c;
+      emit(index & 0xFF);
+      emit(index >> 8);
+      emit(count);
+      checksum += (index & 0xFF) + (index >> 8) + count;
+      for (uint8_t i = 0; i < count; i++, c++) {
+        uint8_t *copy = shadow + (ty + r) * shadowRow + c * 8;
+        emitTile(tileAt(c, r), oldAt(c, r));
+        if (!keyframe) memcpy(copy, tileAt(c, r), 8);
+      }
+    }
+  }
+  emit(checksum);
+  drain();
+
+  packets++;
+  keyframe = false;
+}
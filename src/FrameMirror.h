@@ -0,0 +1,88 @@
+#pragma once
+
+#include <functional>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Mirror stream format. Each packet:
+ *   0xFE 'P'       marker, to find packets again after noise or other output on the same port
+ *   1 byte         'K' for a keyframe (the decoder starts from a blank screen) or 'D' for changes
+ *   2 bytes        payload length, little endian
+ *   payload        display width and height in tiles (1 byte each), then runs of changed tiles:
+ *                    2 bytes   index of the first tile (row * width + column), little endian
+ *                    1 byte    number of tiles in the run
+ *                    tiles     each one either
+ *                                0x00, v      all 8 bytes of the tile are v
+ *                                m, x...      m != 0: XOR the tile's byte i with the next x byte for every bit i set
+ *                                             in m (the 8 bytes are columns, bit 0 at the top)
+ *   1 byte         sum of the payload bytes, modulo 256
+ * tools/mirror.py decodes it.
+ */
+
+/**
+ * @class FrameMirror
+ * @brief Streams what the display shows to another machine, as compressed changes of 8x8 tiles
+ *
+ * Attach it with PixelView::setMirror(). Everything PixelView sends to the display is compared with a copy of
+ * what was mirrored so far and only the tiles that changed go out, usually 2 to 4 bytes each, so the bandwidth
+ * follows how much of the screen changes rather than the frame rate. Costs one frame of RAM (1 KB on 128x64).
+ *
+ * ```cpp
+ * FrameMirror mirror([](const uint8_t *data, size_t length) { Serial.write(data, length); });
+ * pv.setMirror(&mirror);
+ * ```
+ */
+class FrameMirror {
+public:
+  typedef std::function<void(const uint8_t *data, size_t length)> WriteFuncType;
+
+  /**
+   * @param write Sends bytes to the viewer: a UART, a pipe, a socket...
+   * @param keyframeEvery Send the whole screen every this many packets, so a viewer that connects late or
+   *                      loses a packet catches up. 0 only sends it first and on requestKeyframe()
+   */
+  explicit FrameMirror(WriteFuncType write, unsigned long keyframeEvery = 0);
+  FrameMirror(const FrameMirror &) = delete;
+  FrameMirror &operator=(const FrameMirror &) = delete;
+  ~FrameMirror();
+
+  /**
+   * @brief Allocates the copy of the screen. Called by PixelView::setMirror()
+   * @return false if there's not enough memory
+   */
+  bool begin(uint8_t tilesWide, uint8_t tilesHigh);
+
+  /**
+   * @brief Sends the tiles of tx..tx+tw, ty..ty+th that changed since they were last mirrored
+   *
+   * @param rows The buffer holding tile row `ty`, `rowBytes` bytes per tile row
+   */
+  void update(const uint8_t *rows, size_t rowBytes, uint8_t tx, uint8_t ty, uint8_t tw, uint8_t th);
+
+  /**
+   * @brief Makes the next update() send the whole screen, e.g. when a viewer connects
+   */
+  void requestKeyframe() { keyframe = true; }
+
+  unsigned long packets = 0;
+  unsigned long bytesSent = 0;
+
+private:
+  WriteFuncType write;
+  unsigned long keyframeEvery;
+  uint8_t *shadow = NULL; // What the viewer shows, in the display's tile layout
+  uint8_t tilesWide = 0;
+  uint8_t tilesHigh = 0;
+  bool keyframe = true;
+
+  // Bytes are sent in chunks of this buffer
+  uint8_t out[64];
+  size_t outLength = 0;
+  uint8_t checksum = 0;
+
+  static size_t encodedSize(const uint8_t *tile, const uint8_t *old);
+  void emit(uint8_t byte);
+  void emitTile(const uint8_t *tile, const uint8_t *old);
+  void drain();
+};
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <stdint.h>
+
+// The panel PixelView lays its widgets out for. Override with build flags for other panels, e.g. in platformio.ini:
+//   build_flags = -DPIXELVIEW_DISPLAY_WIDTH=128 -DPIXELVIEW_DISPLAY_HEIGHT=32
+#ifndef PIXELVIEW_DISPLAY_WIDTH
+#define PIXELVIEW_DISPLAY_WIDTH 128
+#endif
+#ifndef PIXELVIEW_DISPLAY_HEIGHT
+#define PIXELVIEW_DISPLAY_HEIGHT 64
+#endif
+
+/**
+ * @struct GeometryFor
+ * @brief Layout of every built-in widget for a W x H panel, computed at compile time
+ *
+ * The constants are enumerators so they fold into the drawing code and cost no RAM or flash. The values for
+ * 128x64 are the original hand-tuned layout; other sizes scale the number of rows and the widths.
+ *
+ * @note The keyboard and numpad need at least 64 pixels of height
+ */
+template <int16_t W, int16_t H> struct GeometryFor {
+  enum : int16_t {
+    WIDTH = W,
+    HEIGHT = H,
+
+    // Scrollbar: a dotted track in the rightmost 8 columns with a 3 pixel wide handle
+    SCROLLBAR_X = W - 8,
+    SCROLLBAR_HANDLE_X = W - 3,
+
+    // menu(): an odd number of 22 pixel rows with the selected one in the middle
+    MENU_ROW_HEIGHT = 22,
+    MENU_ROWS = (H + 2) / 22 > 1 ? (((H + 2) / 22 - 1) | 1) : 1,
+    MENU_TOP = (H + 2 - MENU_ROWS * 22) / 2,
+    MENU_OUTLINE_RIGHT = W - 6,
+
+    // subMenu()/searchList(): header, then an odd number of 16 pixel rows with the selected one in the middle
+    LIST_ROW_HEIGHT = 16,
+    LIST_ROWS = (H - 12) / 16 > 1 ? (((H - 12) / 16 - 1) | 1) : 1,
+    LIST_FIRST_BASELINE = 28,
+    LIST_HIGHLIGHT_WIDTH = W - 7,
+
+    // radioSelect()/checkBoxes(): header, then 11 pixel rows
+    CHECK_ROWS = (H - 17) / 11 > 1 ? (H - 17) / 11 : 1,
+
+    // logViewer(): header, then 10 pixel rows of 6 pixel wide characters
+    LOG_ROW_HEIGHT = 10,
+    LOG_ROWS = (H - 14) / 10 > 1 ? (H - 14) / 10 : 1,
+    LOG_FIRST_BASELINE = 22,
+    LOG_COLUMNS = (W - 9) / 6,
+
+    // gridMenu(): 16 pixel icons 4 pixels apart, scrolling by rows
+    GRID_COLUMNS = (W - 4) / 20,
+    GRID_ROWS = (H - 4) / 20 > 1 ? (H - 4) / 20 : 1,
+
+    // carousel(): the default icon size, as tall as fits
+    CAROUSEL_ICON = H < 64 ? 32 : 64,
+
+    // progressBar(): below the header; on short panels the percentage goes inside the bar
+    PROGRESS_BAR_Y = H >= 64 ? H / 2 + 3 : 14,
+    PROGRESS_TEXT_INSIDE = H < 64,
+    PROGRESS_TEXT_Y = H >= 64 ? PROGRESS_BAR_Y - 5 : PROGRESS_BAR_Y + 12,
+
+    // progressCircle(): 8 dots around this centre
+    CIRCLE_X = W / 2 - 1,
+    CIRCLE_Y = H >= 64 ? H / 2 + 5 : H / 2,
+    CIRCLE_RADIUS = H >= 64 ? 17 : H / 2 - 4,
+
+    // confirmYN()/showMessage() buttons
+    BUTTON_Y = H - 14,
+    YES_X = W * 21 / 64,
+    NO_X = W * 21 / 32,
+    OKAY_X = W / 2 - 6,
+    OKAY_Y = H - 8,
+  };
+};
+
+typedef GeometryFor<PIXELVIEW_DISPLAY_WIDTH, PIXELVIEW_DISPLAY_HEIGHT> Geometry;
@@ -0,0 +1,143 @@
+#include "InputTrace.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(ARDUINO)
+#include <Arduino.h>
+#else
+#include <chrono>
+#endif
+
+static const uint8_t MAGIC[4] = {'P', 'V', 'I', '1'};
+static const uint8_t END_CODE = 0xFF;
+
+static unsigned long defaultClock() {
+#if defined(ARDUINO)
+  return millis();
+#else
+  static auto start = std::chrono::steady_clock::now();
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+#endif
+}
+
+InputRecorder::InputRecorder(std::function<ActionType(void)> input, size_t capacity, ClockFuncType clock)
+    : wrapped(input), clock(clock ? clock : defaultClock), capacity(capacity) {
+  buffer = (uint8_t *)malloc(capacity);
+  if (buffer == NULL || capacity < sizeof(MAGIC)) {
+    full = true;
+    return;
+  }
+  memcpy(buffer, MAGIC, sizeof(MAGIC));
+  length = sizeof(MAGIC);
+}
+
+InputRecorder::~InputRecorder() { free(buffer); }
+
+ActionType InputRecorder::poll() {
+  ActionType action = wrapped();
+  if (finished) return action;
+
+  if (!started) {
+    lastMS = clock();
+    started = true;
+  }
+  if (action != last) {
+    record((uint8_t)action);
+    last = action;
+  }
+  polls++;
+  return action;
+}
+
+void InputRecorder::finish() {
+  if (finished) return;
+  if (!started) lastMS = clock();
+  record(END_CODE);
+  finished = true;
+}
+
+void InputRecorder::record(uint8_t code) {
+  if (full) return;
+
+  unsigned long now = clock();
+  uint8_t bytes[1 + 2 * 5];
+  size_t n = 0;
+  bytes[n++] = code;
+  unsigned long values[2] = {polls, now - lastMS};
+  for (unsigned long value : values) {
+    do {
+      bytes[n] = value & 0x7F;
+      value >>= 7;
+      if (value) bytes[n] |= 0x80;
+      n++;
+    } while (value);
+  }
+
+  // Drop the whole record rather than leave half of it
+  if (length + n > capacity) {
+    full = true;
+    return;
+  }
+  memcpy(buffer + length, bytes, n);
+  length += n;
+  count += code != END_CODE;
+  polls = 0;
+  lastMS = now;
+}
+
+InputReplayer::InputReplayer(const uint8_t *trace, size_t length, Timing timing, ClockFuncType clock)
+    : trace(trace), length(length), pos(sizeof(MAGIC)), timing(timing), clock(clock ? clock : defaultClock) {
+  ok = trace != NULL && length >= sizeof(MAGIC) && memcmp(trace, MAGIC, sizeof(MAGIC)) == 0;
+  if (ok) readNext();
+}
+
+void InputReplayer::readNext() {
+  hasNext = false;
+  if (pos >= length) return;
+
+  uint8_t code = trace[pos++];
+  unsigned long values[2] = {0, 0};
+  for (unsigned long &value : values) {
+    int shift = 0;
+    uint8_t byte;
+    do {
+      if (pos >= length) return; // Truncated
+      byte = trace[pos++];
+      value |= (unsigned long)(byte & 0x7F) << shift;
+      shift += 7;
+    } while (byte & 0x80);
+  }
+
+  nextCode = code;
+  nextPoll += values[0];
+  nextMS += values[1];
+  hasNext = true;
+}
+
+ActionType InputReplayer::poll() {
+  if (!started) {
+    startMS = clock();
+    started = true;
+  }
+
+  // At most one transition per poll, so even the shortest press is seen
+  bool due = timing == Timing::POLLS ? polls >= nextPoll : clock() - startMS >= nextMS;
+  if (hasNext && due) {
+    if (nextCode == END_CODE) {
+      hasNext = false;
+      current = ActionType::NONE;
+    } else {
+      current = nextCode <= (uint8_t)ActionType::NONE ? (ActionType)nextCode : ActionType::NONE;
+      readNext();
+    }
+  }
+  polls++;
+
+  if (!hasNext && !finished) {
+    finished = true;
+    current = ActionType::NONE;
+    if (onFinished) onFinished();
+  }
+  return current;
+}
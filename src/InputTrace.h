@@ -0,0 +1,174 @@
+#pragma once
+
+#include "actions.h"
+#include <functional>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Input traces: the ActionType transitions of a session, so it can be replayed exactly.
+ *
+ * Binary format: the 4 byte magic "PVI1", then one record per transition:
+ *   1 byte   the new ActionType (0-5), or 0xFF for the end of the session
+ *   varint   doInput() polls since the previous record
+ *   varint   milliseconds since the previous record
+ * Varints are LEB128: 7 bits per byte, least significant first, high bit set on all but the last byte.
+ * tools/inputtrace.py converts traces to and from a text form that can be read and edited.
+ */
+
+/**
+ * @class InputRecorder
+ * @brief Wraps an input function and records every change of the ActionType it returns
+ *
+ * ```cpp
+ * InputRecorder recorder(pv.doInput);
+ * pv.doInput = recorder.input();
+ * ...
+ * recorder.finish();
+ * Serial.write(recorder.data(), recorder.size());
+ * ```
+ *
+ * Only transitions are stored (about 3 bytes each), so a 200 keystroke session takes a little over 1 KB.
+ */
+class InputRecorder {
+public:
+  typedef std::function<unsigned long(void)> ClockFuncType;
+
+  /**
+   * @param input The input function to record, usually the current PixelView::doInput
+   * @param capacity Bytes of trace to keep. Recording stops when it's full, see overflowed()
+   * @param clock Returns milliseconds. Defaults to millis()
+   */
+  InputRecorder(std::function<ActionType(void)> input, size_t capacity = 1024, ClockFuncType clock = NULL);
+  InputRecorder(const InputRecorder &) = delete;
+  InputRecorder &operator=(const InputRecorder &) = delete;
+  ~InputRecorder();
+
+  /**
+   * @brief Calls the wrapped input function and records its result if it changed
+   */
+  ActionType poll();
+
+  /**
+   * @brief An input function for PixelView::doInput that calls poll()
+   */
+  std::function<ActionType(void)> input() {
+    return [this]() { return poll(); };
+  }
+
+  /**
+   * @brief Ends the trace, recording how long the session went on after the last transition. Nothing is
+   *        recorded afterwards
+   */
+  void finish();
+
+  const uint8_t *data() const { return buffer; }
+  size_t size() const { return length; }
+
+  /**
+   * @brief Number of transitions recorded
+   */
+  size_t events() const { return count; }
+
+  /**
+   * @brief true if the trace didn't fit in `capacity` bytes and was cut short
+   */
+  bool overflowed() const { return full; }
+
+private:
+  std::function<ActionType(void)> wrapped;
+  ClockFuncType clock;
+  uint8_t *buffer;
+  size_t capacity;
+  size_t length = 0;
+  size_t count = 0;
+  bool full = false;
+  bool finished = false;
+
+  ActionType last = ActionType::NONE;
+  unsigned long polls = 0;  // Polls since the last record
+  unsigned long lastMS = 0; // Time of the last record
+  bool started = false;
+
+  void record(uint8_t code);
+};
+
+/**
+ * @class InputReplayer
+ * @brief An input function that plays a recorded trace back
+ *
+ * With Timing::POLLS each transition happens at the same doInput() call as when it was recorded, whatever the
+ * time, so replaying against the same code draws exactly the same frames. Timing::CLOCK follows the recorded
+ * timestamps instead, which keeps a session meaningful when the code under test polls at a different rate;
+ * pass a simulated clock to make it deterministic too. Either way every transition is seen by at least one
+ * poll.
+ *
+ * ```cpp
+ * InputReplayer replay(trace, traceLength);
+ * replay.onFinished = [] { throw SessionOver(); };
+ * pv.doInput = replay.input();
+ * ```
+ */
+class InputReplayer {
+public:
+  typedef std::function<unsigned long(void)> ClockFuncType;
+
+  enum class Timing { POLLS, CLOCK };
+
+  /**
+   * @param trace A trace from InputRecorder. It's read in place, so it must outlive the replayer
+   * @param clock Returns milliseconds, for Timing::CLOCK. Defaults to millis()
+   */
+  InputReplayer(const uint8_t *trace, size_t length, Timing timing = Timing::POLLS, ClockFuncType clock = NULL);
+
+  /**
+   * @brief The action at this point of the trace. NONE once the trace is over
+   */
+  ActionType poll();
+
+  /**
+   * @brief An input function for PixelView::doInput that calls poll()
+   */
+  std::function<ActionType(void)> input() {
+    return [this]() { return poll(); };
+  }
+
+  /**
+   * @brief Called once, from poll(), when the end of the session is reached. Widgets wait for input forever, so
+   *        a benchmark usually stops here (e.g. by throwing on the host)
+   */
+  std::function<void(void)> onFinished;
+
+  /**
+   * @brief false if the trace doesn't start with the magic number
+   */
+  bool valid() const { return ok; }
+  bool isFinished() const { return finished; }
+
+  /**
+   * @brief Polls so far
+   */
+  unsigned long getPolls() const { return polls; }
+
+private:
+  const uint8_t *trace;
+  size_t length;
+  size_t pos;
+  Timing timing;
+  ClockFuncType clock;
+  bool ok;
+  bool finished = false;
+
+  ActionType current = ActionType::NONE;
+  unsigned long polls = 0;
+  unsigned long startMS = 0;
+  bool started = false;
+
+  // The next record, decoded ahead of time
+  uint8_t nextCode = 0;
+  unsigned long nextPoll = 0; // Poll index it happens at
+  unsigned long nextMS = 0;   // Time since the start it happens at
+  bool hasNext = false;
+
+  void readNext();
+};
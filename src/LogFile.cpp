@@ -0,0 +1,200 @@
+#include "LogFile.h"
+
+#if defined(PIXELVIEW_LOG_FS) || defined(PIXELVIEW_LOG_POSIX)
+
+#include <new>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(PIXELVIEW_LOG_POSIX)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+LogFile::LogFile(uint16_t stride) : stride(stride > 0 ? stride : 1) {}
+
+LogFile::~LogFile() {
+  close();
+  delete[] checkpoints;
+}
+
+#if defined(PIXELVIEW_LOG_POSIX)
+bool LogFile::open(const char *path) {
+  close();
+  fd = ::open(path, O_RDONLY);
+  if (fd < 0) return false;
+  fileSize = currentSize();
+  reset();
+  return true;
+}
+
+void LogFile::close() {
+  if (fd >= 0) ::close(fd);
+  fd = -1;
+  fileSize = 0;
+  reset();
+}
+
+bool LogFile::isOpen() const { return fd >= 0; }
+
+size_t LogFile::currentSize() {
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size < 0) return 0;
+  // A file past what size_t can address (on a 32-bit host) is read up to there
+  return (uintmax_t)st.st_size > SIZE_MAX ? SIZE_MAX : (size_t)st.st_size;
+}
+
+size_t LogFile::readAt(size_t offset, size_t length) {
+  ssize_t read = pread(fd, window, length, (off_t)offset);
+  return read > 0 ? (size_t)read : 0;
+}
+#else
+bool LogFile::open(fs::File logFile) {
+  close();
+  if (!logFile) return false;
+  file = logFile;
+  fileSize = currentSize();
+  reset();
+  return true;
+}
+
+void LogFile::close() {
+  if (file) file.close();
+  file = fs::File();
+  fileSize = 0;
+  reset();
+}
+
+bool LogFile::isOpen() const { return (bool)file; }
+
+size_t LogFile::currentSize() { return file.size(); }
+
+size_t LogFile::readAt(size_t offset, size_t length) {
+  return file.seek(offset) ? file.read((uint8_t *)window, length) : 0;
+}
+#endif
+
+// A file truncated since the last refresh() reads short here rather than faulting, so its lines come out empty
+const char *LogFile::bytesAt(size_t offset, size_t wanted, size_t &available) {
+  if (offset >= fileSize) {
+    available = 0;
+    return window;
+  }
+  if (wanted > WINDOW_SIZE) wanted = WINDOW_SIZE;
+  if (wanted > fileSize - offset) wanted = fileSize - offset;
+  if (offset < windowStart || offset + wanted > windowStart + windowLength) {
+    size_t length = fileSize - offset < WINDOW_SIZE ? fileSize - offset : WINDOW_SIZE;
+    windowStart = offset;
+    windowLength = readAt(offset, length);
+  }
+  available = windowStart + windowLength - offset;
+  return window + (offset - windowStart);
+}
+
+void LogFile::reset() {
+  numCheckpoints = 0;
+  addCheckpoint(0);
+  newlines = 0;
+  lastLineStart = 0;
+  indexedTo = 0;
+  walkLine = 0;
+  walkOffset = 0;
+  windowStart = windowLength = 0;
+}
+
+bool LogFile::addCheckpoint(size_t offset) {
+  if (numCheckpoints == checkpointCapacity) {
+    size_t capacity = checkpointCapacity > 0 ? checkpointCapacity * 2 : 64;
+    size_t *grown = new (std::nothrow) size_t[capacity];
+    if (grown == NULL) return false; // Keep the checkpoints there are; line() walks further from the last one
+    if (checkpoints != NULL) memcpy(grown, checkpoints, numCheckpoints * sizeof(size_t));
+    delete[] checkpoints;
+    checkpoints = grown;
+    checkpointCapacity = capacity;
+  }
+  checkpoints[numCheckpoints++] = offset;
+  return true;
+}
+
+bool LogFile::refresh() {
+  if (!isOpen()) return false;
+  size_t size = currentSize();
+  if (size == fileSize) return false;
+
+  if (size < fileSize) reset();
+  fileSize = size;
+  windowStart = windowLength = 0;
+  return true;
+}
+
+bool LogFile::index(size_t budget) {
+  size_t end = fileSize - indexedTo > budget ? indexedTo + budget : fileSize;
+  while (indexedTo < end) {
+    size_t available;
+    const char *start = bytesAt(indexedTo, 1, available);
+    if (available == 0) {
+      refresh(); // Shorter than it was: truncated, so index it again
+      break;
+    }
+    size_t length = end - indexedTo < available ? end - indexedTo : available;
+    const char *p = start;
+    const char *last = start + length;
+    while ((p = (const char *)memchr(p, '\n', last - p)) != NULL) {
+      p++;
+      newlines++;
+      lastLineStart = indexedTo + (p - start);
+      // Once growing the checkpoints fails, later ones would be misnumbered
+      if (newlines % stride == 0 && numCheckpoints == newlines / stride) addCheckpoint(lastLineStart);
+    }
+    indexedTo += length;
+  }
+  return indexed();
+}
+
+size_t LogFile::lineStart(size_t n) {
+  // Past the checkpoints kept (growing them failed) walk from the last one. Line 0 is always at offset 0
+  size_t checkpoint = n / stride;
+  if (checkpoint >= numCheckpoints) checkpoint = numCheckpoints > 0 ? numCheckpoints - 1 : 0;
+  size_t line = checkpoint * stride;
+  size_t offset = checkpoint > 0 ? checkpoints[checkpoint] : 0;
+  if (walkLine > line && walkLine <= n) {
+    line = walkLine;
+    offset = walkOffset;
+  }
+
+  while (line < n) {
+    size_t available;
+    const char *p = bytesAt(offset, 1, available);
+    if (available > indexedTo - offset) available = indexedTo - offset;
+    if (available == 0) break;
+    const char *lineBreak = (const char *)memchr(p, '\n', available);
+    if (lineBreak == NULL) {
+      offset += available;
+      continue;
+    }
+    offset += lineBreak - p + 1;
+    line++;
+  }
+
+  walkLine = line;
+  walkOffset = offset;
+  return offset;
+}
+
+LogFile::Span LogFile::line(size_t n) {
+  Span span = {"", 0};
+  if (n >= lines()) return span;
+
+  size_t start = lineStart(n);
+  size_t available;
+  const char *p = bytesAt(start, WINDOW_SIZE, available);
+  if (available > indexedTo - start) available = indexedTo - start;
+  const char *lineBreak = (const char *)memchr(p, '\n', available);
+  span.data = p;
+  span.length = lineBreak != NULL ? lineBreak - p : available;
+  if (span.length > 0 && p[span.length - 1] == '\r') span.length--;
+  return span;
+}
+
+#endif
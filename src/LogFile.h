@@ -0,0 +1,129 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(ESP32)
+#include <FS.h>
+#define PIXELVIEW_LOG_FS
+#elif !defined(ARDUINO) && (defined(__unix__) || defined(__APPLE__))
+#define PIXELVIEW_LOG_POSIX
+#endif
+
+#if defined(PIXELVIEW_LOG_FS) || defined(PIXELVIEW_LOG_POSIX)
+
+/**
+ * @class LogFile
+ * @brief A text file too big for RAM, read a line at a time for PixelView::logViewer()
+ *
+ * The file isn't loaded: it's read through a WINDOW_SIZE byte window, with pread() on the host and from SD,
+ * LittleFS or SPIFFS on ESP32. index() finds the line breaks a bounded number of bytes at a time, so a viewer stays
+ * responsive while a multi-megabyte log is scanned, and refresh() picks up lines appended since. A file truncated by
+ * another process reads as empty lines until refresh() sees it.
+ *
+ * Only the offset of every `stride`-th line is kept (a size_t each); line() walks forward from the nearest one.
+ * Offsets are size_t, so on 32-bit targets files are limited to 4 GB. Lines are returned as spans into the window,
+ * without copying or NUL-terminating them.
+ *
+ * ```cpp
+ * LogFile log;
+ * log.open(SD.open("/system.log"));
+ * pv.logViewer("System log", log);
+ * ```
+ */
+class LogFile {
+public:
+  /**
+   * @brief Characters of a line, not NUL-terminated and without the line break
+   */
+  struct Span {
+    const char *data;
+    size_t length;
+  };
+
+  // Bytes read from the file at once, and the longest line returned whole
+  static const size_t WINDOW_SIZE = 256;
+
+  /**
+   * @param stride Lines between two indexed offsets: more uses less RAM, fewer makes jumps faster
+   */
+  explicit LogFile(uint16_t stride = 16);
+  LogFile(const LogFile &) = delete;
+  LogFile &operator=(const LogFile &) = delete;
+  ~LogFile();
+
+#if defined(PIXELVIEW_LOG_POSIX)
+  bool open(const char *path);
+#else
+  /**
+   * @param file Opened for reading, e.g. SD.open("/system.log")
+   */
+  bool open(fs::File file);
+#endif
+  void close();
+  bool isOpen() const;
+
+  /**
+   * @brief Checks whether the file grew or was truncated (e.g. rotated). A truncated file is indexed from scratch
+   * @return true if the size changed. Spans returned before are then invalid
+   */
+  bool refresh();
+
+  /**
+   * @brief Indexes up to `budget` more bytes
+   * @return true once the whole file is indexed
+   */
+  bool index(size_t budget = 16384);
+
+  bool indexed() const { return indexedTo == fileSize; }
+
+  /**
+   * @brief Lines indexed so far, counting a last line without a line break
+   */
+  size_t lines() const { return newlines + (indexedTo > lastLineStart ? 1 : 0); }
+
+  size_t size() const { return fileSize; }
+  size_t indexedSize() const { return indexedTo; }
+
+  /**
+   * @brief Line `n` (from 0, below lines()), without its "\n" or "\r\n". Cut to WINDOW_SIZE bytes
+   *
+   * The span stays valid until the next call to line(), index() or refresh().
+   */
+  Span line(size_t n);
+
+private:
+  uint16_t stride;
+  size_t *checkpoints = NULL; // Offsets of lines 0, stride, 2 * stride...; fewer if growing them failed
+  size_t numCheckpoints = 0;
+  size_t checkpointCapacity = 0;
+  size_t newlines = 0;      // Line breaks in the bytes indexed
+  size_t lastLineStart = 0; // Offset after the last line break
+  size_t indexedTo = 0;
+  size_t fileSize = 0;
+  size_t walkLine = 0; // The last line located by lineStart(), so reading the next ones doesn't start over
+  size_t walkOffset = 0;
+
+  void reset();
+  bool addCheckpoint(size_t offset);
+  size_t lineStart(size_t n);
+
+  /**
+   * @brief The file from `offset` on, at least `wanted` bytes of it when available. `available` is set to the
+   *        bytes that can be read from the returned pointer
+   */
+  const char *bytesAt(size_t offset, size_t wanted, size_t &available);
+  size_t readAt(size_t offset, size_t length);
+  size_t currentSize();
+
+  char window[WINDOW_SIZE];
+  size_t windowStart = 0;
+  size_t windowLength = 0;
+#if defined(PIXELVIEW_LOG_POSIX)
+  int fd = -1;
+#else
+  fs::File file;
+#endif
+};
+
+#endif
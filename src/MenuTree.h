@@ -0,0 +1,64 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @struct MenuNode
+ * @brief One entry of a menu tree declared as constant data: a label, an optional 16x16 XBM icon and either an
+ *        action or a submenu
+ *
+ * Declare the tree `constexpr` with menuAction() and menuNode(), from the leaves up. It is then built by the
+ * compiler and placed in flash (.rodata on ESP32 and ARM), so it costs no RAM and no construction at startup.
+ * PixelView::MenuNavigator walks it.
+ *
+ * ```cpp
+ * constexpr MenuNode displayItems[] = {menuAction("Brightness", setBrightness), menuAction("Flip", flip)};
+ * constexpr MenuNode mainItems[] = {menuNode("Display", displayItems, bmpDisplay), menuAction("About", about)};
+ * constexpr MenuNode mainMenu = menuNode("Settings", mainItems);
+ * ```
+ */
+struct MenuNode {
+  const char *label;
+  const unsigned char *icon; // 16x16 XBM or NULL
+  void (*action)();          // Called when the entry is selected, or NULL
+  const MenuNode *children;  // Submenu entries, or NULL for a leaf
+  uint8_t numChildren;
+
+  bool isSubmenu() const { return numChildren > 0; }
+};
+
+/**
+ * @brief A leaf entry that calls `action` (which may be NULL) when selected
+ */
+constexpr MenuNode menuAction(const char *label, void (*action)(), const unsigned char *icon = NULL) {
+  return {label, icon, action, NULL, 0};
+}
+
+/**
+ * @brief An entry that opens a submenu holding `children`
+ */
+template <size_t N>
+constexpr MenuNode menuNode(const char *label, const MenuNode (&children)[N], const unsigned char *icon = NULL) {
+  static_assert(N > 0 && N < 256, "a submenu needs 1 to 255 entries");
+  return {label, icon, NULL, children, (uint8_t)N};
+}
+
+constexpr uint8_t menuDepth(const MenuNode &node);
+
+constexpr uint8_t menuDepthMax(uint8_t a, uint8_t b) { return a > b ? a : b; }
+
+/**
+ * @brief The deepest menuDepth() among `n` entries
+ */
+constexpr uint8_t menuDepth(const MenuNode *entries, uint8_t n) {
+  return n == 0 ? 0 : menuDepthMax(menuDepth(entries[0]), menuDepth(entries + 1, n - 1));
+}
+
+/**
+ * @brief Number of nested menus below and including `node`: 0 for a leaf, 1 for a menu of leaves. The stack depth
+ *        PixelView::MenuNavigator needs for the tree, e.g. `PixelView::MenuNavigator<menuDepth(mainMenu)>`
+ */
+constexpr uint8_t menuDepth(const MenuNode &node) {
+  return node.numChildren == 0 ? 0 : 1 + menuDepth(node.children, node.numChildren);
+}
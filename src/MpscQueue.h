@@ -0,0 +1,87 @@
+#pragma once
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+#include <utility>
+
+/**
+ * @class MpscQueue
+ * @brief A bounded lock-free queue that any number of tasks push into and a single task pops from
+ *
+ * Each slot carries a sequence number that tells producers whether it's free and the consumer whether it's
+ * been filled (D. Vyukov's bounded queue). push() claims a slot with one compare-and-swap and never blocks or
+ * allocates; it fails when the queue is full. Storage is allocated once, on construction.
+ */
+template <typename T> class MpscQueue {
+public:
+  /**
+   * @param capacity Rounded up to a power of two
+   */
+  explicit MpscQueue(size_t capacity) {
+    size_t n = 2;
+    while (n < capacity) n <<= 1;
+    cells = new Cell[n];
+    mask = n - 1;
+    for (size_t i = 0; i < n; i++) cells[i].sequence.store(i, std::memory_order_relaxed);
+  }
+  MpscQueue(const MpscQueue &) = delete;
+  MpscQueue &operator=(const MpscQueue &) = delete;
+  ~MpscQueue() { delete[] cells; }
+
+  /**
+   * @brief Adds `value` at the back. Safe from any task
+   * @return false if the queue is full
+   */
+  bool push(T &&value) {
+    Cell *cell;
+    size_t pos = tail.load(std::memory_order_relaxed);
+    while (true) {
+      cell = &cells[pos & mask];
+      intptr_t diff = (intptr_t)cell->sequence.load(std::memory_order_acquire) - (intptr_t)pos;
+      if (diff == 0) {
+        if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+      } else if (diff < 0) {
+        return false; // The consumer hasn't freed this slot yet
+      } else {
+        pos = tail.load(std::memory_order_relaxed); // Another producer took it
+      }
+    }
+    cell->value = std::move(value);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Takes the front element into `value`. Only call from the consumer
+   * @return false if the queue is empty
+   */
+  bool pop(T &value) {
+    Cell &cell = cells[head & mask];
+    if ((intptr_t)cell.sequence.load(std::memory_order_acquire) - (intptr_t)(head + 1) < 0) return false;
+    value = std::move(cell.value);
+    cell.sequence.store(head + mask + 1, std::memory_order_release);
+    head++;
+    return true;
+  }
+
+  /**
+   * @brief true if there's nothing to pop. Only exact from the consumer
+   */
+  bool empty() const {
+    return (intptr_t)cells[head & mask].sequence.load(std::memory_order_acquire) - (intptr_t)(head + 1) < 0;
+  }
+
+  size_t capacity() const { return mask + 1; }
+
+private:
+  struct Cell {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  Cell *cells;
+  size_t mask;
+  std::atomic<size_t> tail{0}; // Next slot producers claim
+  size_t head = 0;             // Next slot the consumer reads
+};
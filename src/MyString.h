@@ -4,112 +4,260 @@
 
 #include <string>
 #include <cstring>
+#include <cstdlib>
+#include <cstdio>
 #include <algorithm>
 #include <cctype>
-#include <sstream>
+#include <utility>
+
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
 
 #include "StringUtils.h"
 
 /**
  * @class String
- * @brief A lightweight wrapper around std::string that mimics Arduino's String class
- * 
+ * @brief A lightweight string that mimics Arduino's String class
+ *
  * This implementation provides the core functionality of Arduino's String class
- * while using std::string internally for better performance on Raspberry Pi.
+ * for non-Arduino targets (e.g. Raspberry Pi). Strings that fit in SSO_CAPACITY
+ * characters (most UI labels) are stored inline without touching the heap, and
+ * the class is movable, so returning a String by value (fullKeyboard, numPad,
+ * substring, operator+) does not deep-copy.
  */
 class String {
+public:
+    static const unsigned int SSO_CAPACITY = 23; // Characters stored inline (excluding the terminator)
+
 private:
-    std::string data;
+    char *buf;        // Points at `sso` or at a heap block
+    unsigned int len; // Length excluding the terminator
+    unsigned int cap; // Usable capacity excluding the terminator
+    char sso[SSO_CAPACITY + 1];
+
+    bool isInline() const { return buf == sso; }
+
+    void initEmpty() {
+        buf = sso;
+        len = 0;
+        cap = SSO_CAPACITY;
+        sso[0] = '\0';
+    }
+
+    // Grows the buffer to hold at least `size` characters, keeping the contents.
+    // Returns false, leaving the string as it was, if the memory can't be allocated
+    bool grow(unsigned int size) {
+        if (size <= cap) return true;
+        unsigned int newCap = std::max(size, cap + cap / 2);
+        char *block = static_cast<char *>(std::malloc(newCap + 1));
+        if (block == nullptr) return false;
+        std::memcpy(block, buf, len + 1);
+        if (!isInline()) std::free(buf);
+        buf = block;
+        cap = newCap;
+        return true;
+    }
+
+    void assign(const char *str, unsigned int n) {
+        if (n > cap) {
+            // Nothing to keep, so drop the old block before growing
+            if (!isInline()) std::free(buf);
+            initEmpty();
+            if (!grow(n)) return; // Left empty, like Arduino's String
+        }
+        std::memmove(buf, str, n);
+        len = n;
+        buf[len] = '\0';
+    }
+
+    void append(const char *str, unsigned int n) {
+        if (n == 0) return;
+        if (len + n > cap) {
+            // `str` may point into our own buffer, so copy before reallocating
+            if (str >= buf && str < buf + len) {
+                unsigned int off = static_cast<unsigned int>(str - buf);
+                if (!grow(len + n)) return;
+                str = buf + off;
+            } else if (!grow(len + n)) {
+                return;
+            }
+        }
+        std::memmove(buf + len, str, n);
+        len += n;
+        buf[len] = '\0';
+    }
+
+    void moveFrom(String &other) {
+        if (other.isInline()) {
+            initEmpty();
+            std::memcpy(sso, other.sso, other.len + 1);
+            len = other.len;
+        } else {
+            buf = other.buf;
+            len = other.len;
+            cap = other.cap;
+        }
+        other.initEmpty();
+    }
+
+    int find(const char *needle, unsigned int n, unsigned int fromIndex) const {
+        if (fromIndex > len || n > len - fromIndex) return -1;
+        const char *hit = std::search(buf + fromIndex, buf + len, needle, needle + n);
+        return (hit == buf + len && n != 0) ? -1 : static_cast<int>(hit - buf);
+    }
+
+    // Formats straight into the tail of the buffer, reserving `maxChars` first
+    template <typename Formatter> void appendWith(unsigned int maxChars, Formatter format) {
+        if (!grow(len + maxChars)) return;
+        len = static_cast<unsigned int>(format(buf + len) - buf);
+    }
 
 public:
     // Constructors
-    String() = default;
-    String(const char* str) : data(str ? str : "") {}
-    String(const std::string& str) : data(str) {}
-    String(const String& str) : data(str.data) {}
-    String(char c) : data(1, c) {}
-    String(unsigned char c) : data(1, static_cast<char>(c)) {}
+    String() { initEmpty(); }
+    String(const char* str) {
+        initEmpty();
+        if (str) assign(str, static_cast<unsigned int>(std::strlen(str)));
+    }
+    String(const char* str, unsigned int length) {
+        initEmpty();
+        if (str) assign(str, length);
+    }
+    String(const std::string& str) {
+        initEmpty();
+        assign(str.data(), static_cast<unsigned int>(str.length()));
+    }
+#if __cplusplus >= 201703L
+    explicit String(std::string_view str) {
+        initEmpty();
+        assign(str.data(), static_cast<unsigned int>(str.length()));
+    }
+#endif
+    String(const String& str) {
+        initEmpty();
+        assign(str.buf, str.len);
+    }
+    String(String&& str) noexcept { moveFrom(str); }
+    String(char c) {
+        initEmpty();
+        assign(&c, 1);
+    }
+    String(unsigned char c) {
+        initEmpty();
+        char ch = static_cast<char>(c);
+        assign(&ch, 1);
+    }
     String(int value, unsigned char base = 10);
     String(unsigned int value, unsigned char base = 10);
     String(long value, unsigned char base = 10);
     String(unsigned long value, unsigned char base = 10);
     String(float value, unsigned char decimalPlaces = 2);
     String(double value, unsigned char decimalPlaces = 2);
-    
+
+    ~String() {
+        if (!isInline()) std::free(buf);
+    }
+
     // Assignment
     String& operator=(const String& rhs) {
-        if (this != &rhs) data = rhs.data;
+        if (this != &rhs) assign(rhs.buf, rhs.len);
+        return *this;
+    }
+    String& operator=(String&& rhs) noexcept {
+        if (this != &rhs) {
+            if (!isInline()) std::free(buf);
+            moveFrom(rhs);
+        }
         return *this;
     }
     String& operator=(const char* cstr) {
-        data = cstr ? cstr : "";
+        if (cstr) assign(cstr, static_cast<unsigned int>(std::strlen(cstr)));
+        else assign("", 0);
         return *this;
     }
-    
+
     // Access
     char charAt(unsigned int index) const {
-        return (index < data.length()) ? data[index] : 0;
+        return (index < len) ? buf[index] : 0;
     }
     void setCharAt(unsigned int index, char c) {
-        if (index < data.length()) data[index] = c;
+        if (index < len) buf[index] = c;
     }
     char operator[](unsigned int index) const {
         return charAt(index);
     }
     char& operator[](unsigned int index) {
         static char dummy = 0;
-        return (index < data.length()) ? data[index] : dummy;
+        return (index < len) ? buf[index] : dummy;
     }
-    
+
     // Comparison
-    bool equals(const String& s) const { return data == s.data; }
-    bool equals(const char* s) const { return data == s; }
+    int compareTo(const String& s) const {
+        int cmp = std::memcmp(buf, s.buf, std::min(len, s.len));
+        if (cmp != 0) return cmp;
+        return (len < s.len) ? -1 : (len > s.len) ? 1 : 0;
+    }
+    bool equals(const String& s) const { return len == s.len && std::memcmp(buf, s.buf, len) == 0; }
+    bool equals(const char* s) const {
+        if (!s) return len == 0;
+        return std::strlen(s) == len && std::memcmp(buf, s, len) == 0;
+    }
     bool operator==(const String& rhs) const { return equals(rhs); }
     bool operator==(const char* rhs) const { return equals(rhs); }
     bool operator!=(const String& rhs) const { return !equals(rhs); }
     bool operator!=(const char* rhs) const { return !equals(rhs); }
-    bool operator<(const String& rhs) const { return data < rhs.data; }
-    bool operator>(const String& rhs) const { return data > rhs.data; }
-    bool operator<=(const String& rhs) const { return data <= rhs.data; }
-    bool operator>=(const String& rhs) const { return data >= rhs.data; }
-    
+    bool operator<(const String& rhs) const { return compareTo(rhs) < 0; }
+    bool operator>(const String& rhs) const { return compareTo(rhs) > 0; }
+    bool operator<=(const String& rhs) const { return compareTo(rhs) <= 0; }
+    bool operator>=(const String& rhs) const { return compareTo(rhs) >= 0; }
+
     // Concatenation
     String& concat(const String& str) {
-        data += str.data;
+        append(str.buf, str.len);
         return *this;
     }
     String& concat(const char* cstr) {
-        if (cstr) data += cstr;
-        return *this;
-    }
-    String& concat(char c) {
-        data += c;
+        if (cstr) append(cstr, static_cast<unsigned int>(std::strlen(cstr)));
         return *this;
     }
-    String& concat(unsigned char c) {
-        data += static_cast<char>(c);
-        return *this;
-    }
-    String& concat(int num) {
-        data += std::to_string(num);
+    String& concat(const char* cstr, unsigned int length) {
+        if (cstr) append(cstr, length);
         return *this;
     }
-    String& concat(unsigned int num) {
-        data += std::to_string(num);
+    String& concat(char c) {
+        append(&c, 1);
         return *this;
     }
-    String& concat(long num) {
-        data += std::to_string(num);
+    String& concat(unsigned char c) {
+        return concat(static_cast<char>(c));
+    }
+    String& concat(int num) { return concatNumber(static_cast<long>(num)); }
+    String& concat(unsigned int num) { return concatNumber(static_cast<unsigned long>(num)); }
+    String& concat(long num) { return concatNumber(num); }
+    String& concat(unsigned long num) { return concatNumber(num); }
+    String& concat(float num) { return concatFixed(num, 2); }
+    String& concat(double num) { return concatFixed(num, 2); }
+
+    /**
+     * @brief Appends an integer in any base (2..36) directly into the buffer
+     */
+    String& concatNumber(long num, unsigned char base = 10) {
+        appendWith(StringUtils::MAX_INT_CHARS, [num, base](char *out) { return StringUtils::appendSigned(out, num, base); });
         return *this;
     }
-    String& concat(unsigned long num) {
-        data += std::to_string(num);
+    String& concatNumber(unsigned long num, unsigned char base = 10) {
+        appendWith(StringUtils::MAX_INT_CHARS, [num, base](char *out) { return StringUtils::appendUnsigned(out, num, base); });
         return *this;
     }
-    String& concat(float num) {
-        std::ostringstream oss;
-        oss << num;
-        data += oss.str();
+
+    /**
+     * @brief Appends a fixed-point number directly into the buffer
+     */
+    String& concatFixed(double num, unsigned char decimalPlaces = 2) {
+        appendWith(StringUtils::MAX_FIXED_CHARS, [num, decimalPlaces](char *out) {
+            return StringUtils::appendFixed(out, num, decimalPlaces);
+        });
         return *this;
     }
     String& operator+=(const String& rhs) { return concat(rhs); }
@@ -120,176 +268,177 @@ public:
     String& operator+=(unsigned int num) { return concat(num); }
     String& operator+=(long num) { return concat(num); }
     String& operator+=(unsigned long num) { return concat(num); }
-    
+
     // Combination
     friend String operator+(const String& lhs, const String& rhs) {
-        String result = lhs;
-        result.concat(rhs);
+        String result;
+        result.reserve(lhs.len + rhs.len);
+        result.append(lhs.buf, lhs.len);
+        result.append(rhs.buf, rhs.len);
         return result;
     }
+    friend String operator+(String&& lhs, const String& rhs) {
+        lhs.concat(rhs);
+        return std::move(lhs);
+    }
     friend String operator+(const String& lhs, const char* rhs) {
         String result = lhs;
         result.concat(rhs);
         return result;
     }
+    friend String operator+(String&& lhs, const char* rhs) {
+        lhs.concat(rhs);
+        return std::move(lhs);
+    }
     friend String operator+(const char* lhs, const String& rhs) {
         String result = lhs;
         result.concat(rhs);
         return result;
     }
-    
+
     // Search
     int indexOf(char ch) const {
-        size_t pos = data.find(ch);
-        return (pos == std::string::npos) ? -1 : static_cast<int>(pos);
+        return indexOf(ch, 0);
     }
     int indexOf(char ch, unsigned int fromIndex) const {
-        size_t pos = data.find(ch, fromIndex);
-        return (pos == std::string::npos) ? -1 : static_cast<int>(pos);
+        if (fromIndex >= len) return -1;
+        const void *hit = std::memchr(buf + fromIndex, ch, len - fromIndex);
+        return hit ? static_cast<int>(static_cast<const char *>(hit) - buf) : -1;
     }
     int indexOf(const String& str) const {
-        size_t pos = data.find(str.data);
-        return (pos == std::string::npos) ? -1 : static_cast<int>(pos);
+        return find(str.buf, str.len, 0);
     }
     int indexOf(const String& str, unsigned int fromIndex) const {
-        size_t pos = data.find(str.data, fromIndex);
-        return (pos == std::string::npos) ? -1 : static_cast<int>(pos);
+        return find(str.buf, str.len, fromIndex);
     }
     int lastIndexOf(char ch) const {
-        size_t pos = data.rfind(ch);
-        return (pos == std::string::npos) ? -1 : static_cast<int>(pos);
+        return lastIndexOf(ch, len == 0 ? 0 : len - 1);
     }
     int lastIndexOf(char ch, unsigned int fromIndex) const {
-        if (fromIndex >= data.length()) fromIndex = data.length() - 1;
-        size_t pos = data.rfind(ch, fromIndex);
-        return (pos == std::string::npos) ? -1 : static_cast<int>(pos);
+        if (len == 0) return -1;
+        if (fromIndex >= len) fromIndex = len - 1;
+        for (int i = static_cast<int>(fromIndex); i >= 0; i--) {
+            if (buf[i] == ch) return i;
+        }
+        return -1;
     }
-    
+
     // Modification
     void replace(char find, char replace) {
-        std::replace(data.begin(), data.end(), find, replace);
+        std::replace(buf, buf + len, find, replace);
     }
     void replace(const String& find, const String& replace) {
-        size_t pos = 0;
-        while ((pos = data.find(find.data, pos)) != std::string::npos) {
-            data.replace(pos, find.length(), replace.data);
-            pos += replace.length();
+        if (find.len == 0) return;
+        String result;
+        result.reserve(len);
+        unsigned int pos = 0;
+        int hit;
+        while ((hit = this->find(find.buf, find.len, pos)) >= 0) {
+            result.append(buf + pos, static_cast<unsigned int>(hit) - pos);
+            result.append(replace.buf, replace.len);
+            pos = static_cast<unsigned int>(hit) + find.len;
         }
+        result.append(buf + pos, len - pos);
+        *this = std::move(result);
     }
     String substring(unsigned int beginIndex) const {
-        if (beginIndex >= data.length()) return String();
-        return String(data.substr(beginIndex));
+        if (beginIndex >= len) return String();
+        return String(buf + beginIndex, len - beginIndex);
     }
     String substring(unsigned int beginIndex, unsigned int endIndex) const {
-        if (beginIndex >= data.length()) return String();
-        return String(data.substr(beginIndex, endIndex - beginIndex));
+        if (beginIndex > endIndex) std::swap(beginIndex, endIndex);
+        if (beginIndex >= len) return String();
+        if (endIndex > len) endIndex = len;
+        return String(buf + beginIndex, endIndex - beginIndex);
     }
     void remove(unsigned int index) {
-        if (index < data.length()) {
-            data.erase(index);
+        if (index < len) {
+            len = index;
+            buf[len] = '\0';
         }
     }
     void remove(unsigned int index, unsigned int count) {
-        if (index < data.length()) {
-            data.erase(index, count);
+        if (index < len) {
+            count = std::min(count, len - index);
+            std::memmove(buf + index, buf + index + count, len - index - count + 1);
+            len -= count;
         }
     }
     void toLowerCase() {
-        std::transform(data.begin(), data.end(), data.begin(), 
-                      [](unsigned char c){ return std::tolower(c); });
+        std::transform(buf, buf + len, buf,
+                      [](unsigned char c){ return static_cast<char>(std::tolower(c)); });
     }
     void toUpperCase() {
-        std::transform(data.begin(), data.end(), data.begin(), 
-                      [](unsigned char c){ return std::toupper(c); });
+        std::transform(buf, buf + len, buf,
+                      [](unsigned char c){ return static_cast<char>(std::toupper(c)); });
     }
     void trim() {
-        // Trim left
-        data.erase(data.begin(), std::find_if(data.begin(), data.end(), [](unsigned char ch) {
-            return !std::isspace(ch);
-        }));
-        // Trim right
-        data.erase(std::find_if(data.rbegin(), data.rend(), [](unsigned char ch) {
-            return !std::isspace(ch);
-        }).base(), data.end());
-    }
-    
+        unsigned int first = 0;
+        while (first < len && std::isspace(static_cast<unsigned char>(buf[first]))) first++;
+        unsigned int last = len;
+        while (last > first && std::isspace(static_cast<unsigned char>(buf[last - 1]))) last--;
+        len = last - first;
+        std::memmove(buf, buf + first, len);
+        buf[len] = '\0';
+    }
+
     // Conversion
-    const char* c_str() const { return data.c_str(); }
-    char* begin() { return &data[0]; }
-    char* end() { return &data[0] + data.length(); }
-    const char* begin() const { return data.c_str(); }
-    const char* end() const { return data.c_str() + data.length(); }
-    
-    int toInt() const { return std::stoi(data); }
-    float toFloat() const { return std::stof(data); }
-    double toDouble() const { return std::stod(data); }
-    
+    const char* c_str() const { return buf; }
+    char* begin() { return buf; }
+    char* end() { return buf + len; }
+    const char* begin() const { return buf; }
+    const char* end() const { return buf + len; }
+
+    int toInt() const { return static_cast<int>(std::strtol(buf, nullptr, 10)); }
+    float toFloat() const { return std::strtof(buf, nullptr); }
+    double toDouble() const { return std::strtod(buf, nullptr); }
+
     // Properties
-    unsigned int length() const { return static_cast<unsigned int>(data.length()); }
-    bool isEmpty() const { return data.empty(); }
-    void reserve(unsigned int size) { data.reserve(size); }
-    
+    unsigned int length() const { return len; }
+    bool isEmpty() const { return len == 0; }
+    bool reserve(unsigned int size) { return grow(size); }
+
+    // Non-owning accessors. Valid until the String is modified or destroyed
+    const char* data() const { return buf; }
+    unsigned int size() const { return len; }
+#if __cplusplus >= 201703L
+    std::string_view view() const { return std::string_view(buf, len); }
+#endif
+
     // Conversion operators
-    operator std::string() const { return data; }
+    operator std::string() const { return std::string(buf, len); }
     operator const char*() const { return c_str(); }
 };
 
 // Constructor implementations
 inline String::String(int value, unsigned char base) {
-    char buf[34];
-    if (base == 10) {
-        data = std::to_string(value);
-    } else {
-        // Implementation for non-base-10 conversions
-        // (This is simplified; you may need to improve this for your needs)
-        itoa(value, buf, base);
-        data = buf;
-    }
+    initEmpty();
+    concatNumber(static_cast<long>(value), base);
 }
 
 inline String::String(unsigned int value, unsigned char base) {
-    char buf[34];
-    if (base == 10) {
-        data = std::to_string(value);
-    } else {
-        // Implementation for non-base-10 conversions
-        utoa(value, buf, base);
-        data = buf;
-    }
+    initEmpty();
+    concatNumber(static_cast<unsigned long>(value), base);
 }
 
 inline String::String(long value, unsigned char base) {
-    char buf[34];
-    if (base == 10) {
-        data = std::to_string(value);
-    } else {
-        // Implementation for non-base-10 conversions
-        ltoa(value, buf, base);
-        data = buf;
-    }
+    initEmpty();
+    concatNumber(value, base);
 }
 
 inline String::String(unsigned long value, unsigned char base) {
-    char buf[34];
-    if (base == 10) {
-        data = std::to_string(value);
-    } else {
-        // Implementation for non-base-10 conversions
-        ultoa(value, buf, base);
-        data = buf;
-    }
+    initEmpty();
+    concatNumber(value, base);
 }
 
 inline String::String(float value, unsigned char decimalPlaces) {
-    char buf[34];
-    snprintf(buf, sizeof(buf), "%.*f", decimalPlaces, value);
-    data = buf;
+    initEmpty();
+    concatFixed(value, decimalPlaces);
 }
 
 inline String::String(double value, unsigned char decimalPlaces) {
-    char buf[34];
-    snprintf(buf, sizeof(buf), "%.*f", decimalPlaces, value);
-    data = buf;
+    initEmpty();
+    concatFixed(value, decimalPlaces);
 }
 
 #endif
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "TileBitmap.h"
+#include <U8g2lib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @class PackedBitmap
+ * @brief Reads the compressed 1bpp bitmaps made by `tools/xbm2tiles.py --pack`
+ *
+ * A packed bitmap is a TileBitmap compressed with run-length encoding (PackBits): the blank or solid stretches
+ * that make up most of an icon take 2 bytes each. It starts with a header, so it can be passed wherever an XBM
+ * icon is (menuItem::icon, gridMenu(), listBrowser(), StatusIcon, carousel()) and PixelView tells them apart.
+ *
+ * ```
+ * 0xF7 'P' 'V' 'Z' width height    header
+ * 0x00..0x7F                       n + 1 literal bytes follow
+ * 0x80..0xFF                       the next byte, repeated n - 0x80 + 3 times
+ * ```
+ *
+ * The codes decode to the TileBitmap layout, so a bitmap can be decoded a tile row at a time straight into the
+ * frame buffer, or whole into a cache.
+ */
+class PackedBitmap {
+public:
+  static const size_t HEADER_SIZE = 6;
+
+  /**
+   * @brief true if `data` (in PROGMEM) starts with the packed bitmap header
+   */
+  static bool isPacked(const uint8_t *data) {
+    return data != NULL && byteAt(data) == 0xF7 && byteAt(data + 1) == 'P' && byteAt(data + 2) == 'V' &&
+           byteAt(data + 3) == 'Z';
+  }
+
+  /**
+   * @param data A packed bitmap in PROGMEM
+   */
+  explicit PackedBitmap(const uint8_t *data) : next(data + HEADER_SIZE), w(byteAt(data + 4)), h(byteAt(data + 5)) {}
+
+  uint8_t width() const { return w; }
+  uint8_t height() const { return h; }
+
+  /**
+   * @brief Decodes the next `length` bytes of the bitmap, in the TileBitmap layout
+   */
+  void read(uint8_t *out, size_t length) {
+    while (length > 0) {
+      if (count == 0) {
+        uint8_t code = byteAt(next++);
+        repeat = code & 0x80;
+        count = repeat ? code - 0x80 + 3 : code + 1;
+        if (repeat) value = byteAt(next++);
+      }
+      size_t n = count < length ? count : length;
+      if (repeat) memset(out, value, n);
+      else
+        for (size_t i = 0; i < n; i++)
+          out[i] = byteAt(next++);
+      out += n;
+      length -= n;
+      count -= n;
+    }
+  }
+
+  /**
+   * @brief Decodes the whole bitmap into TileBitmap::bytesFor(width(), height()) bytes
+   */
+  void decode(uint8_t *tiles) { read(tiles, TileBitmap::bytesFor(w, h)); }
+
+private:
+  const uint8_t *next;
+  uint8_t w;
+  uint8_t h;
+  size_t count = 0; // Bytes left in the current code
+  bool repeat = false;
+  uint8_t value = 0;
+
+  static uint8_t byteAt(const uint8_t *p) { return u8x8_pgm_read(p); }
+};
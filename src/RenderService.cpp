@@ -0,0 +1,182 @@
+#include "RenderService.h"
+
+#if defined(PIXELVIEW_HAS_ATOMIC)
+
+#include "pixelView.h"
+#include <string.h>
+
+#if defined(PIXELVIEW_RENDER_THREAD)
+#include <chrono>
+#endif
+
+RenderService::RenderService(PixelView *pixelView, size_t capacity)
+    : px(pixelView), queue(capacity), batch(new Command[queue.capacity()]) {}
+
+RenderService::~RenderService() {
+  if (started) {
+    stopping = true;
+#if defined(PIXELVIEW_RENDER_FREERTOS)
+    xTaskNotifyGive(task);
+    xSemaphoreTake(stopped, portMAX_DELAY);
+    vSemaphoreDelete(stopped);
+#elif defined(PIXELVIEW_RENDER_THREAD)
+    wake.notify_all();
+    thread.join();
+#endif
+  }
+  delete[] batch;
+}
+
+bool RenderService::begin(int core, unsigned priority, uint32_t stackSize) {
+  if (started) return true;
+
+#if defined(PIXELVIEW_RENDER_FREERTOS)
+  stopped = xSemaphoreCreateBinary();
+  if (stopped == NULL) return false;
+  BaseType_t affinity = core < 0 ? tskNO_AFFINITY : core;
+  if (xTaskCreatePinnedToCore(taskMain, "pixelViewRender", stackSize, this, priority, &task, affinity) != pdPASS) {
+    vSemaphoreDelete(stopped);
+    stopped = NULL;
+    return false;
+  }
+  started = true;
+  return true;
+#elif defined(PIXELVIEW_RENDER_THREAD)
+  (void)core;
+  (void)priority;
+  (void)stackSize;
+  thread = std::thread(&RenderService::threadMain, this);
+  started = true;
+  return true;
+#else
+  (void)core;
+  (void)priority;
+  (void)stackSize;
+  return false;
+#endif
+}
+
+bool RenderService::progress(int percent, const char *header) {
+  Command command;
+  command.type = Command::Type::PROGRESS;
+  command.key = PROGRESS_KEY;
+  command.value = percent;
+  copyText(command, header);
+  return post(std::move(command));
+}
+
+bool RenderService::text(const char *message, uint16_t key) {
+  Command command;
+  command.type = Command::Type::TEXT;
+  command.key = key;
+  copyText(command, message);
+  return post(std::move(command));
+}
+
+void RenderService::copyText(Command &command, const char *text) {
+  if (text == NULL) text = "";
+  strncpy(command.text, text, sizeof(command.text) - 1);
+  command.text[sizeof(command.text) - 1] = '\0';
+}
+
+bool RenderService::run(DrawFuncType draw, uint16_t key) {
+  Command command;
+  command.type = Command::Type::RUN;
+  command.key = key;
+  command.draw = std::move(draw);
+  return post(std::move(command));
+}
+
+bool RenderService::post(Command &&command) {
+  if (!queue.push(std::move(command))) {
+    dropped++;
+    return false;
+  }
+  posted++;
+  signal();
+  return true;
+}
+
+void RenderService::signal() {
+#if defined(PIXELVIEW_RENDER_FREERTOS)
+  if (started) xTaskNotifyGive(task);
+#elif defined(PIXELVIEW_RENDER_THREAD)
+  wake.notify_one();
+#endif
+}
+
+void RenderService::process() {
+  // Take everything waiting. A command replaces an earlier one with the same key, which is then never drawn
+  size_t count = 0;
+  while (count < queue.capacity() && queue.pop(batch[count])) {
+    Command &command = batch[count];
+    if (command.key != 0) {
+      for (size_t i = 0; i < count; i++) {
+        if (batch[i].type != Command::Type::NONE && batch[i].key == command.key) {
+          batch[i].type = Command::Type::NONE;
+          batch[i].draw = nullptr;
+          coalesced++;
+          finished++;
+        }
+      }
+    }
+    count++;
+  }
+
+  for (size_t i = 0; i < count; i++) {
+    Command &command = batch[i];
+    switch (command.type) {
+    case Command::Type::PROGRESS:
+      px->progressBar(command.value, command.text);
+      break;
+    case Command::Type::TEXT:
+      px->showText(command.text);
+      break;
+    case Command::Type::RUN:
+      command.draw(*px);
+      command.draw = nullptr;
+      break;
+    case Command::Type::NONE:
+      continue;
+    }
+    executed++;
+    finished++;
+  }
+}
+
+void RenderService::wait() {
+  while (finished.load() != posted.load()) {
+    if (!started) {
+      process();
+      continue;
+    }
+#if defined(PIXELVIEW_RENDER_FREERTOS)
+    vTaskDelay(1);
+#elif defined(PIXELVIEW_RENDER_THREAD)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+#endif
+  }
+}
+
+#if defined(PIXELVIEW_RENDER_FREERTOS)
+void RenderService::taskMain(void *self) {
+  RenderService *service = static_cast<RenderService *>(self);
+  while (!service->stopping) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    service->process();
+  }
+  xSemaphoreGive(service->stopped);
+  vTaskDelete(NULL);
+}
+#elif defined(PIXELVIEW_RENDER_THREAD)
+void RenderService::threadMain() {
+  while (!stopping) {
+    process();
+    // Producers notify without taking the mutex, so a wakeup can be missed: never sleep for long
+    std::unique_lock<std::mutex> lock(mutex);
+    wake.wait_for(lock, std::chrono::milliseconds(5), [this] { return stopping || !queue.empty(); });
+  }
+}
+#endif
+
+#endif
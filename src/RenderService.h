@@ -0,0 +1,150 @@
+#pragma once
+
+#include <functional>
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(ESP32)
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#define PIXELVIEW_RENDER_FREERTOS
+#elif !defined(ARDUINO)
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#define PIXELVIEW_RENDER_THREAD
+#endif
+
+// The queue needs <atomic>, which some toolchains (e.g. AVR) don't have
+#if defined(__has_include)
+#if __has_include(<atomic>)
+#define PIXELVIEW_HAS_ATOMIC
+#endif
+#elif defined(PIXELVIEW_RENDER_FREERTOS) || defined(PIXELVIEW_RENDER_THREAD)
+#define PIXELVIEW_HAS_ATOMIC
+#endif
+
+#if defined(PIXELVIEW_HAS_ATOMIC)
+
+#include "MpscQueue.h"
+
+class PixelView;
+
+/**
+ * @class RenderService
+ * @brief Owns a PixelView (and its display) on one task and draws what other tasks ask for
+ *
+ * PixelView and U8G2 aren't thread safe. Instead of sharing them behind a mutex, tasks post commands to the
+ * service, which is the only one drawing. Posting never blocks: commands go through a bounded lock-free queue
+ * and are dropped (and counted) when it's full. progress() and text() don't allocate either. run() takes a
+ * std::function, which allocates when the callable doesn't fit inside it: with GCC, lambdas capturing more than
+ * two pointers, or anything that isn't trivially copyable. Capture a single pointer to your state to avoid it.
+ *
+ * Before each batch of drawing, commands with the same key are coalesced: only the most recent one runs. Ten
+ * progress updates posted while a frame was on the bus cost one frame, not ten.
+ *
+ * The service runs on a FreeRTOS task on ESP32 and a std::thread on the host. Elsewhere, call process() from
+ * loop().
+ *
+ * ```cpp
+ * RenderService ui(&pv);
+ * ui.begin(1);                           // Pinned to core 1
+ * ui.progress(40, "Downloading");        // From any task
+ * ui.run([](PixelView &pv) { temp.update(); }, 'T');
+ * ```
+ */
+class RenderService {
+public:
+  typedef std::function<void(PixelView &pv)> DrawFuncType;
+
+  // Keys of the built-in commands. Your own keys can be anything else but 0, which is never coalesced
+  static const uint16_t PROGRESS_KEY = 0xFFFF;
+  static const uint16_t TEXT_KEY = 0xFFFE;
+
+  /**
+   * @param capacity Commands that can wait at once, rounded up to a power of two
+   */
+  explicit RenderService(PixelView *pixelView, size_t capacity = 32);
+  RenderService(const RenderService &) = delete;
+  RenderService &operator=(const RenderService &) = delete;
+  ~RenderService();
+
+  /**
+   * @brief Starts the task that draws
+   * @param core ESP32 core to pin it to, or -1 for any
+   * @return false if the task couldn't be started, or on platforms without tasks (call process() yourself)
+   */
+  bool begin(int core = -1, unsigned priority = 1, uint32_t stackSize = 4096);
+
+  /**
+   * @brief Shows PixelView::progressBar(). Coalesced with other progress updates
+   * @param header Copied (up to 63 characters). NULL shows no header
+   * @return false if the queue was full
+   */
+  bool progress(int percent, const char *header);
+
+  /**
+   * @brief Shows PixelView::showText(). `message` is copied (up to 63 characters), NULL shows an empty screen
+   */
+  bool text(const char *message, uint16_t key = TEXT_KEY);
+
+  /**
+   * @brief Runs `draw` on the service's task. It may draw anything, e.g. update BoundWidgets or call drawRegion()
+   *
+   * Building the std::function from a lambda with large captures allocates, see the class description.
+   *
+   * @param key Only the last command posted with this key runs, 0 to always run
+   */
+  bool run(DrawFuncType draw, uint16_t key = 0);
+
+  /**
+   * @brief Takes every waiting command, coalesces them and runs them. Called by the task; call it from loop()
+   *        when begin() returned false
+   */
+  void process();
+
+  /**
+   * @brief Returns once every command posted so far has run (or was coalesced)
+   */
+  void wait();
+
+  std::atomic<unsigned long> dropped{0}; // Commands lost because the queue was full
+  unsigned long executed = 0;            // Commands run
+  unsigned long coalesced = 0;           // Commands replaced by a later one with the same key
+
+private:
+  struct Command {
+    enum class Type : uint8_t { NONE, PROGRESS, TEXT, RUN };
+    Type type = Type::NONE;
+    uint16_t key = 0;
+    int value = 0;
+    char text[64];
+    DrawFuncType draw;
+  };
+
+  PixelView *px;
+  MpscQueue<Command> queue;
+  Command *batch; // Commands taken by process(), queue.capacity() of them
+  std::atomic<unsigned long> posted{0};
+  std::atomic<unsigned long> finished{0};
+  std::atomic<bool> stopping{false};
+  bool started = false;
+
+  bool post(Command &&command);
+  void signal();
+  static void copyText(Command &command, const char *text); // NULL is copied as ""
+
+#if defined(PIXELVIEW_RENDER_FREERTOS)
+  TaskHandle_t task = NULL;
+  SemaphoreHandle_t stopped = NULL; // Given by the task when it exits
+  static void taskMain(void *self);
+#elif defined(PIXELVIEW_RENDER_THREAD)
+  std::thread thread;
+  std::mutex mutex; // Only for sleeping: the queue itself is lock-free
+  std::condition_variable wake;
+  void threadMain();
+#endif
+};
+
+#endif
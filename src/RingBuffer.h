@@ -0,0 +1,43 @@
+#pragma once
+
+#include <stddef.h>
+
+/**
+ * @class RingBuffer
+ * @brief A fixed-capacity circular buffer. Storage is allocated once, on construction.
+ *        When full, push() overwrites the oldest element.
+ *
+ * Elements are indexed oldest first: buffer[0] is the oldest, buffer[size() - 1] the newest.
+ */
+template <typename T> class RingBuffer {
+public:
+  explicit RingBuffer(size_t capacity) : storage(new T[capacity > 0 ? capacity : 1]), cap(capacity > 0 ? capacity : 1) {}
+  RingBuffer(const RingBuffer &) = delete;
+  RingBuffer &operator=(const RingBuffer &) = delete;
+  ~RingBuffer() { delete[] storage; }
+
+  void push(const T &value) {
+    storage[head] = value;
+    head = (head + 1 == cap) ? 0 : head + 1;
+    if (count < cap) count++;
+  }
+
+  const T &operator[](size_t index) const {
+    size_t i = head + cap - count + index;
+    return storage[i >= cap ? i - cap : i];
+  }
+
+  const T &newest() const { return (*this)[count - 1]; }
+
+  size_t size() const { return count; }
+  size_t capacity() const { return cap; }
+  bool empty() const { return count == 0; }
+  bool full() const { return count == cap; }
+  void clear() { head = count = 0; }
+
+private:
+  T *storage;
+  size_t cap;
+  size_t head = 0; // Where the next element is written
+  size_t count = 0;
+};
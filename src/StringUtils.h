@@ -1,131 +1,224 @@
 #pragma once
 
-#ifndef ARDUINO
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <type_traits>
 
 /**
- * @brief Convert integer to string
+ * @brief Allocation free number formatting
  *
- * This is a replacement for the standard itoa function which may not be
- * available on all systems
+ * Every formatter writes into a caller supplied buffer and returns a pointer to the
+ * written terminator, so calls can be chained to build a label in place:
+ *
+ *   char buf[32];
+ *   char *p = StringUtils::appendUnsigned(buf, current);
+ *   p = StringUtils::appendStr(p, " of ");
+ *   StringUtils::appendUnsigned(p, total);
+ *
+ * Base 10 emits two digits per division using a digit-pair table, power-of-two
+ * bases use shifts and masks, and any other base (up to 36) falls back to plain
+ * division. Floats are formatted as fixed point without going through printf.
  */
-inline char *itoa(int value, char *result, int base) {
-  if (base < 2 || base > 36) {
-    *result = '\0';
-    return result;
-  }
-
-  char *ptr = result, *ptr1 = result, tmp_char;
-  int tmp_value;
+namespace StringUtils {
 
-  do {
-    tmp_value = value;
-    value /= base;
-    *ptr++ = "0123456789abcdefghijklmnopqrstuvwxyz"[abs(tmp_value - value * base)];
-  } while (value);
+// Enough for a 64-bit value in base 2, a sign and the terminator
+const size_t MAX_INT_CHARS = 66;
 
-  // Apply negative sign
-  if (tmp_value < 0) *ptr++ = '-';
-  *ptr-- = '\0';
+// Buffer size appendFixed needs. Longer snprintf fallbacks are truncated
+const size_t MAX_FIXED_CHARS = 64;
 
-  // Reverse the string
-  while (ptr1 < ptr) {
-    tmp_char = *ptr;
-    *ptr-- = *ptr1;
-    *ptr1++ = tmp_char;
-  }
+const char DIGITS[] = "0123456789abcdefghijklmnopqrstuvwxyz";
 
-  return result;
-}
+const char DIGIT_PAIRS[] = "00010203040506070809"
+                           "10111213141516171819"
+                           "20212223242526272829"
+                           "30313233343536373839"
+                           "40414243444546474849"
+                           "50515253545556575859"
+                           "60616263646566676869"
+                           "70717273747576777879"
+                           "80818283848586878889"
+                           "90919293949596979899";
 
 /**
- * @brief Convert unsigned integer to string
+ * @brief Writes `value` right-aligned so that its last digit lands just before `end`
+ * @return Pointer to the first digit
  */
-inline char *utoa(unsigned int value, char *result, int base) {
-  if (base < 2 || base > 36) {
-    *result = '\0';
-    return result;
+template <typename T> inline char *formatBackward(char *end, T value, unsigned int base) {
+  char *p = end;
+
+  if (base == 10) {
+    while (value >= 100) {
+      const unsigned int pair = static_cast<unsigned int>(value % 100) * 2;
+      value /= 100;
+      *--p = DIGIT_PAIRS[pair + 1];
+      *--p = DIGIT_PAIRS[pair];
+    }
+    if (value >= 10) {
+      const unsigned int pair = static_cast<unsigned int>(value) * 2;
+      *--p = DIGIT_PAIRS[pair + 1];
+      *--p = DIGIT_PAIRS[pair];
+    } else {
+      *--p = static_cast<char>('0' + value);
+    }
+    return p;
   }
 
-  char *ptr = result, *ptr1 = result, tmp_char;
-  unsigned int tmp_value;
+  if ((base & (base - 1)) == 0) { // 2, 4, 8, 16, 32
+    unsigned int shift = 0;
+    while ((1u << shift) < base)
+      shift++;
+    const T mask = static_cast<T>(base - 1);
+    do {
+      *--p = DIGITS[value & mask];
+      value >>= shift;
+    } while (value);
+    return p;
+  }
 
   do {
-    tmp_value = value;
-    value /= base;
-    *ptr++ = "0123456789abcdefghijklmnopqrstuvwxyz"[tmp_value - value * base];
+    const T next = value / base;
+    *--p = DIGITS[value - next * base];
+    value = next;
   } while (value);
+  return p;
+}
 
-  *ptr-- = '\0';
-
-  // Reverse the string
-  while (ptr1 < ptr) {
-    tmp_char = *ptr;
-    *ptr-- = *ptr1;
-    *ptr1++ = tmp_char;
+/**
+ * @brief Appends an unsigned integer in the given base (2..36). Signed values don't compile: use appendSigned()
+ * @return Pointer to the written terminator
+ */
+template <typename T> inline char *appendUnsigned(char *out, T value, unsigned int base = 10) {
+  static_assert(std::is_unsigned<T>::value, "appendUnsigned() needs an unsigned type, use appendSigned()");
+  if (base < 2 || base > 36) {
+    *out = '\0';
+    return out;
   }
-
-  return result;
+  char tmp[MAX_INT_CHARS];
+  char *end = tmp + sizeof(tmp);
+  char *start = formatBackward(end, value, base);
+  const size_t len = end - start;
+  memcpy(out, start, len);
+  out[len] = '\0';
+  return out + len;
 }
 
 /**
- * @brief Convert long integer to string
+ * @brief Appends a signed integer. Negative numbers are prefixed with '-' in every base
+ * @return Pointer to the written terminator
  */
-inline char *ltoa(long value, char *result, int base) {
+template <typename S, typename U> inline char *appendSignedAs(char *out, S value, unsigned int base) {
   if (base < 2 || base > 36) {
-    *result = '\0';
-    return result;
+    *out = '\0';
+    return out;
   }
+  // Negate in the unsigned domain so the most negative value does not overflow
+  U magnitude = static_cast<U>(value);
+  if (value < 0) {
+    *out++ = '-';
+    magnitude = static_cast<U>(0) - magnitude;
+  }
+  return appendUnsigned(out, magnitude, base);
+}
 
-  char *ptr = result, *ptr1 = result, tmp_char;
-  long tmp_value;
+inline char *appendSigned(char *out, int value, unsigned int base = 10) {
+  return appendSignedAs<int, unsigned int>(out, value, base);
+}
+inline char *appendSigned(char *out, long value, unsigned int base = 10) {
+  return appendSignedAs<long, unsigned long>(out, value, base);
+}
+inline char *appendSigned(char *out, long long value, unsigned int base = 10) {
+  return appendSignedAs<long long, unsigned long long>(out, value, base);
+}
 
-  do {
-    tmp_value = value;
-    value /= base;
-    *ptr++ = "0123456789abcdefghijklmnopqrstuvwxyz"[abs(static_cast<int>(tmp_value - value * base))];
-  } while (value);
+/**
+ * @brief Appends a fixed-point representation of `value` with `decimals` digits after the point.
+ *        Rounds half away from zero like Arduino's dtostrf. Values too large for the fast path,
+ *        NaN and infinity fall back to snprintf.
+ * @return Pointer to the written terminator
+ */
+inline char *appendFixed(char *out, double value, unsigned char decimals = 2) {
+  static const uint32_t POW10[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
 
-  // Apply negative sign
-  if (tmp_value < 0) *ptr++ = '-';
-  *ptr-- = '\0';
+  if (isnan(value) || isinf(value) || decimals > 9 || fabs(value) >= 1e9) {
+    const int n = snprintf(out, MAX_FIXED_CHARS, "%.*f", decimals, value);
+    if (n < 0) return out;
+    return out + ((size_t)n < MAX_FIXED_CHARS ? n : MAX_FIXED_CHARS - 1);
+  }
 
-  // Reverse the string
-  while (ptr1 < ptr) {
-    tmp_char = *ptr;
-    *ptr-- = *ptr1;
-    *ptr1++ = tmp_char;
+  if (value < 0) {
+    *out++ = '-';
+    value = -value;
   }
 
-  return result;
+  const uint32_t scale = POW10[decimals];
+  uint32_t whole = static_cast<uint32_t>(value);
+  uint32_t frac = static_cast<uint32_t>((value - whole) * scale + 0.5);
+  if (frac >= scale) { // Rounding carried into the integer part
+    frac -= scale;
+    whole++;
+  }
+
+  out = appendUnsigned(out, whole);
+  if (decimals == 0) return out;
+
+  *out++ = '.';
+  char *end = out + decimals;
+  char *start = formatBackward(end, frac, 10);
+  while (start > out)
+    *--start = '0'; // Left pad the fraction
+  *end = '\0';
+  return end;
 }
 
 /**
- * @brief Convert unsigned long integer to string
+ * @brief Appends a C string
+ * @return Pointer to the written terminator
  */
-inline char *ultoa(unsigned long value, char *result, int base) {
-  if (base < 2 || base > 36) {
-    *result = '\0';
-    return result;
-  }
+inline char *appendStr(char *out, const char *str) {
+  const size_t len = strlen(str);
+  memcpy(out, str, len + 1);
+  return out + len;
+}
 
-  char *ptr = result, *ptr1 = result, tmp_char;
-  unsigned long tmp_value;
+} // namespace StringUtils
 
-  do {
-    tmp_value = value;
-    value /= base;
-    *ptr++ = "0123456789abcdefghijklmnopqrstuvwxyz"[static_cast<int>(tmp_value - value * base)];
-  } while (value);
+#ifndef ARDUINO
+
+/**
+ * @brief Convert integer to string
+ *
+ * This is a replacement for the standard itoa function which may not be
+ * available on all systems
+ */
+inline char *itoa(int value, char *result, int base) {
+  StringUtils::appendSigned(result, value, base);
+  return result;
+}
 
-  *ptr-- = '\0';
+/**
+ * @brief Convert unsigned integer to string
+ */
+inline char *utoa(unsigned int value, char *result, int base) {
+  StringUtils::appendUnsigned(result, value, base);
+  return result;
+}
 
-  // Reverse the string
-  while (ptr1 < ptr) {
-    tmp_char = *ptr;
-    *ptr-- = *ptr1;
-    *ptr1++ = tmp_char;
-  }
+/**
+ * @brief Convert long integer to string
+ */
+inline char *ltoa(long value, char *result, int base) {
+  StringUtils::appendSigned(result, value, base);
+  return result;
+}
 
+/**
+ * @brief Convert unsigned long integer to string
+ */
+inline char *ultoa(unsigned long value, char *result, int base) {
+  StringUtils::appendUnsigned(result, value, base);
   return result;
 }
 
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @struct TileBitmap
+ * @brief A 1bpp bitmap stored like the SSD1306/SH1106 frame buffer: rows of 8 pixel high tiles, one byte per
+ *        column with bit 0 at the top
+ *
+ * Unlike XBM, which U8G2 draws pixel by pixel, these are copied into the buffer a byte at a time (see
+ * PixelView::drawTileBitmap). Convert XBM arrays with `tools/xbm2tiles.py`, or at runtime with
+ * PixelView::convertXBM.
+ */
+struct TileBitmap {
+  uint8_t width;
+  uint8_t height;
+  const uint8_t *data; // (height + 7) / 8 rows of `width` bytes, in PROGMEM
+
+  /**
+   * @brief Number of bytes a width x height bitmap takes
+   */
+  static size_t bytesFor(uint8_t width, uint8_t height) { return (size_t)width * ((height + 7) / 8); }
+};
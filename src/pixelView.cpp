@@ -1,12 +1,16 @@
 #include "pixelView.h"
+#include "StringUtils.h"
 #include "actions.h"
 #include <U8g2lib.h>
+#include <stdlib.h>
 
 #ifndef ARDUINO
 #include <chrono>
 #include <cstdio>
 #include <string.h>
 
+#define memcpy_P memcpy // PROGMEM is ordinary memory on the host
+
 long map(long x, long in_min, long in_max, long out_min, long out_max) {
   return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
 }
@@ -33,16 +37,284 @@ inline unsigned long micros() {
 
 // Implement the constructor
 PixelView::PixelView(U8G2 *display, std::function<ActionType(void)> inputFunction, std::function<void(int)> delayer,
-                     const uint8_t font[])
-    : font(font) {
+                     const uint8_t font[]) {
+  fonts.mono = font;
   u8g2 = display;
   doInput = inputFunction;
   this->doDelay = delayer;
 }
 
+PixelView::~PixelView() {
+  delete flusher;
+  free(iconCache);
+}
+
+bool PixelView::setAsyncFlush(bool enabled) {
+  delete flusher; // Waits for the frame in flight
+  flusher = NULL;
+  if (!enabled) return true;
+
+  flusher = new FlushTask(u8g2);
+  if (!flusher->begin()) {
+    delete flusher;
+    flusher = NULL;
+    return false;
+  }
+#ifndef ARDUINO
+  flusher->simulatedBus = busTiming;
+#endif
+  return true;
+}
+
+void PixelView::waitFlush() {
+  if (flusher != NULL) flusher->wait();
+}
+
+void PixelView::sendFrame() {
+  if (prefetching) return;
+  mirrorTiles(0, 0, u8g2->getBufferTileWidth(), u8g2->getBufferTileHeight());
+  if (flusher != NULL) flusher->submitFrame();
+  else u8g2->sendBuffer();
+  sent(u8g2->getBufferTileWidth(), u8g2->getBufferTileHeight(), true);
+}
+
+void PixelView::setBusTiming(const BusTiming &timing) {
+  busTiming = timing;
+#ifndef ARDUINO
+  if (flusher != NULL) flusher->simulatedBus = timing;
+#endif
+}
+
+bool PixelView::setMirror(FrameMirror *mirror) {
+  this->mirror = NULL;
+  if (mirror == NULL) return true;
+  if (!mirror->begin(u8g2->getBufferTileWidth(), (u8g2->getDisplayHeight() + 7) / 8)) return false;
+  this->mirror = mirror;
+  return true;
+}
+
+void PixelView::mirrorTiles(uint8_t tx, uint8_t ty, uint8_t tw, uint8_t th) {
+  if (mirror == NULL || prefetching) return;
+  size_t rowBytes = (size_t)u8g2->getBufferTileWidth() * 8;
+  mirror->update(u8g2->getBufferPtr() + (ty - u8g2->getBufferCurrTileRow()) * rowBytes, rowBytes, tx, ty, tw, th);
+}
+
+void PixelView::sent(uint8_t tw, uint8_t th, bool frame) {
+  if (prefetching) return;
+  if (frame) stats.frames++;
+  else stats.regions++;
+  stats.bytes += (unsigned long)tw * th * 8;
+
+  unsigned long transfer = busTiming.transferMicros(tw, th);
+  unsigned long now = micros();
+  unsigned long done = now;
+  if (flusher != NULL) {
+    // Queued behind the transfers still on the bus
+    unsigned long start = (long)(busFreeAt - now) > 0 ? busFreeAt : now;
+    done = start + transfer;
+    busFreeAt = done;
+  } else {
+#ifndef ARDUINO
+    // The host backend sent it instantly: take as long as the bus would
+    std::this_thread::sleep_for(std::chrono::microseconds(transfer));
+    done = micros();
+#endif
+  }
+
+  if (probe != NULL) probe->frameSent(done);
+}
+
+void PixelView::sentRegion(const Region &region) {
+  int x0 = std::max<int>(0, region.x);
+  int y0 = std::max<int>(0, region.y);
+  int x1 = std::min<int>(u8g2->getDisplayWidth(), region.x + region.w);
+  int y1 = std::min<int>(u8g2->getDisplayHeight(), region.y + region.h);
+  if (x1 <= x0 || y1 <= y0) return;
+  sent((x1 + 7) / 8 - x0 / 8, (y1 + 7) / 8 - y0 / 8, false);
+}
+
+PixelView::LatencyProbe::LatencyProbe(PixelView *pixelView) : px(pixelView), wrapped(pixelView->doInput) {
+  px->doInput = [this]() { return poll(); };
+  px->probe = this;
+}
+
+PixelView::LatencyProbe::~LatencyProbe() {
+  px->doInput = wrapped;
+  if (px->probe == this) px->probe = NULL;
+}
+
+ActionType PixelView::LatencyProbe::poll() {
+  ActionType action = wrapped();
+  if (action != last && action != ActionType::NONE && !waiting) {
+    waiting = true;
+    pressed = action;
+    pressedAt = micros();
+  }
+  last = action;
+  return action;
+}
+
+void PixelView::LatencyProbe::frameSent(unsigned long doneMicros) {
+  if (!waiting) return;
+  waiting = false;
+
+  unsigned long latency = doneMicros - pressedAt;
+  add(actions[(int)pressed], latency);
+  add(all, latency);
+  if (onSample) onSample(pressed, latency);
+}
+
+void PixelView::LatencyProbe::add(Stats &stats, unsigned long latency) {
+  if (stats.count == 0 || latency < stats.min) stats.min = latency;
+  if (latency > stats.max) stats.max = latency;
+  stats.count++;
+  stats.total += latency;
+  if (budgetMicros != 0 && latency > budgetMicros) stats.overBudget++;
+}
+
+void PixelView::LatencyProbe::reset() {
+  for (Stats &stats : actions) stats = Stats();
+  all = Stats();
+  waiting = false;
+  last = ActionType::NONE;
+}
+
+void PixelView::LatencyProbe::report(const char *name, std::function<void(const char *line)> out) const {
+  static const char *names[] = {"LEFT", "RIGHT", "UP", "DOWN", "SEL"};
+  char line[96];
+  for (int i = 0; i <= (int)ActionType::NONE; i++) {
+    const Stats &stats = i < (int)ActionType::NONE ? actions[i] : all;
+    if (stats.count == 0) continue;
+    snprintf(line, sizeof(line), "%-12s %-5s n=%-4lu min=%6.1fms avg=%6.1fms max=%6.1fms over=%lu", name,
+             i < (int)ActionType::NONE ? names[i] : "all", stats.count, stats.min / 1000.0, stats.average() / 1000.0,
+             stats.max / 1000.0, stats.overBudget);
+    out(line);
+  }
+}
+
+uint32_t PixelView::hashBuffer(uint32_t hash) {
+  const uint8_t *buffer = u8g2->getBufferPtr();
+  size_t length = (size_t)u8g2->getBufferTileWidth() * u8g2->getBufferTileHeight() * 8;
+  for (size_t i = 0; i < length; i++) hash = (hash ^ buffer[i]) * 16777619u;
+  return hash;
+}
+
+PixelView::IdleManager::IdleManager(PixelView *pixelView, unsigned long suspendAfter, unsigned long dimAfter,
+                                    unsigned long sleepAfter)
+    : suspendAfter(suspendAfter), dimAfter(dimAfter), sleepAfter(sleepAfter), px(pixelView),
+      wrapped(pixelView->doInput) {
+  stateSince = lastInput = lastChange = millis();
+  px->doInput = [this]() { return poll(); };
+  px->idle = this;
+}
+
+PixelView::IdleManager::~IdleManager() {
+  wake();
+  px->doInput = wrapped;
+  if (px->idle == this) px->idle = NULL;
+}
+
+ActionType PixelView::IdleManager::poll() {
+  ActionType action = wrapped();
+  unsigned long now = millis();
+  update(now); // Catch up first: the display may have gone dark since the last poll
+  if (action == ActionType::NONE) {
+    swallowing = false;
+    return action;
+  }
+
+  bool dark = state == State::DIMMED || state == State::ASLEEP;
+  lastInput = now;
+  update(now);
+  if (dark || swallowing) {
+    // Held inputs keep being swallowed until released, so one long press doesn't turn into a keypress
+    if (!swallowing) inputsConsumed++;
+    swallowing = true;
+    return ActionType::NONE;
+  }
+  return action;
+}
+
+void PixelView::IdleManager::wake() {
+  lastInput = millis();
+  update(lastInput);
+}
+
+void PixelView::IdleManager::update(unsigned long now) {
+  State next = State::ACTIVE;
+  if (sleepAfter != 0 && now - lastInput >= sleepAfter) next = State::ASLEEP;
+  else if (dimAfter != 0 && now - lastInput >= dimAfter) next = State::DIMMED;
+  else if (suspendAfter != 0 && now - lastInput >= suspendAfter && now - lastChange >= suspendAfter)
+    next = State::SUSPENDED;
+  if (next != state) enter(next, now);
+}
+
+void PixelView::IdleManager::enter(State next, unsigned long now) {
+  spent[(int)state] += now - stateSince;
+  stateSince = now;
+  State previous = state;
+  state = next;
+
+  bool wasDark = previous == State::DIMMED || previous == State::ASLEEP;
+  bool isDark = next == State::DIMMED || next == State::ASLEEP;
+  if (wasDark == isDark && previous != State::ASLEEP && next != State::ASLEEP) return; // ACTIVE <-> SUSPENDED
+
+  // Talking to the display directly: the frame in flight has to be out first
+  px->waitFlush();
+  if (next == State::ASLEEP) px->u8g2->setPowerSave(1);
+  else if (previous == State::ASLEEP) px->u8g2->setPowerSave(0);
+  px->u8g2->setContrast(isDark ? dimContrast : contrast);
+
+  if (previous == State::ASLEEP) {
+    // Nothing was sent while asleep. A full buffer still holds the latest frame; with a page buffer the next
+    // frame drawn will be sent whatever it holds
+    lastHash = 0;
+    if (!px->isPageBuffered()) px->sendFrame();
+  }
+}
+
+unsigned long PixelView::IdleManager::millisIn(State which) const {
+  unsigned long total = spent[(int)which];
+  if (which == state) total += millis() - stateSince;
+  return total;
+}
+
+unsigned long PixelView::IdleManager::idleMillis() const {
+  return millisIn(State::SUSPENDED) + millisIn(State::DIMMED) + millisIn(State::ASLEEP);
+}
+
+bool PixelView::IdleManager::frameReady(uint32_t hash) {
+  unsigned long now = millis();
+  bool changed = hash != lastHash;
+  if (changed && state != State::ASLEEP) {
+    lastHash = hash;
+    lastChange = now;
+  }
+  update(now);
+  if (state == State::ASLEEP || (!changed && state != State::ACTIVE)) {
+    framesSkipped++;
+    return false;
+  }
+  return true;
+}
+
+bool PixelView::IdleManager::regionReady() {
+  unsigned long now = millis();
+  update(now);
+  if (state == State::ASLEEP) {
+    framesSkipped++;
+    return false;
+  }
+  // The screen no longer matches the last frame sent: the next one has to go out even if it hashes the same
+  lastHash = 0;
+  lastChange = now;
+  update(now);
+  return true;
+}
+
 void PixelView::wordWrap(int xloc, int yloc, const char *text, bool maintainX) {
-  int dspwidth = this->u8g2->getDisplayWidth(); // display width in pixels
-  int strwidth = 0;                             // string width in pixels
+  int dspwidth = Geometry::WIDTH; // display width in pixels
+  int strwidth = 0;               // string width in pixels
   char glyph[2];
   int orignalX = xloc;
   glyph[1] = 0;
@@ -95,43 +367,303 @@ void PixelView::accentText(int x, int y, const char *text, const uint8_t font[])
   u8g2->setDrawColor(1);
 }
 
+void PixelView::clearRegion(const Region &region) {
+  u8g2->setDrawColor(0);
+  u8g2->drawBox(region.x, region.y, region.w, region.h);
+  u8g2->setDrawColor(1);
+}
+
+bool PixelView::hasVerticalTileBuffer() {
+  u8g2_t *u = u8g2->getU8g2();
+  return u->cb == U8G2_R0 && u->ll_hvline == u8g2_ll_hvline_vertical_top_lsb &&
+         u8g2->getBufferTileHeight() * 8 >= u8g2->getDisplayHeight();
+}
+
+bool PixelView::shiftRegionLeft(const Region &region, int dx) {
+  if (!hasVerticalTileBuffer()) return false;
+
+  int x0 = std::max<int>(0, region.x);
+  int y0 = std::max<int>(0, region.y);
+  int x1 = std::min<int>(u8g2->getDisplayWidth(), region.x + region.w);
+  int y1 = std::min<int>(u8g2->getDisplayHeight(), region.y + region.h);
+  if (x1 <= x0 || y1 <= y0 || dx <= 0) return true;
+  dx = std::min(dx, x1 - x0);
+
+  uint8_t *buf = u8g2->getBufferPtr();
+  int rowBytes = u8g2->getBufferTileWidth() * 8;
+
+  for (int tileRow = y0 / 8; tileRow <= (y1 - 1) / 8; tileRow++) {
+    // Bits of this tile row that lie inside the region
+    int top = std::max(y0, tileRow * 8) - tileRow * 8;
+    int bottom = std::min(y1, tileRow * 8 + 8) - tileRow * 8;
+    uint8_t mask = (uint8_t)(((1u << bottom) - 1) & ~((1u << top) - 1));
+
+    uint8_t *row = buf + tileRow * rowBytes;
+    for (int x = x0; x < x1 - dx; x++)
+      row[x] = (row[x] & ~mask) | (row[x + dx] & mask);
+    for (int x = x1 - dx; x < x1; x++)
+      row[x] &= ~mask;
+  }
+  return true;
+}
+
+void PixelView::blitTiles(int x, int y, uint8_t w, uint8_t h, const uint8_t *data, bool progmem) {
+  u8g2_t *u = u8g2->getU8g2();
+  uint8_t color = u->draw_color;
+  bool solid = u->bitmap_transparency == 0;
+
+  if (u->cb != U8G2_R0 || u->ll_hvline != u8g2_ll_hvline_vertical_top_lsb || color != 1) {
+    // Same as drawXBMP(): set bits in the draw color, clear bits in the other one unless the mode is transparent
+    for (int j = 0; j < h; j++) {
+      for (int i = 0; i < w; i++) {
+        const uint8_t *p = data + (j / 8) * w + i;
+        if ((progmem ? u8x8_pgm_read(p) : *p) & (1 << (j & 7))) {
+          u->draw_color = color;
+        } else if (solid) {
+          u->draw_color = color == 0 ? 1 : 0;
+        } else {
+          continue;
+        }
+        u8g2->drawPixel(x + i, y + j);
+      }
+    }
+    u->draw_color = color;
+    return;
+  }
+
+#ifdef U8G2_WITH_CLIP_WINDOW_SUPPORT
+  if (!u->is_page_clip_window_intersection) return;
+#endif
+  // The user window is the clip window intersected with the current page (the whole display with a full buffer)
+  int x0 = std::max<int>(x, u->user_x0);
+  int x1 = std::min<int>(x + w, u->user_x1);
+  int y0 = std::max<int>(y, u->user_y0);
+  int y1 = std::min<int>(y + h, u->user_y1);
+  if (x1 <= x0 || y1 <= y0) return;
+
+  uint8_t *buf = u8g2->getBufferPtr();
+  int rowBytes = u8g2->getBufferTileWidth() * 8;
+  int srcRows = (h + 7) / 8;
+
+  for (int tileRow = y0 / 8; tileRow <= (y1 - 1) / 8; tileRow++) {
+    int top = std::max(y0, tileRow * 8) - tileRow * 8;
+    int bottom = std::min(y1, tileRow * 8 + 8) - tileRow * 8;
+    uint8_t mask = (uint8_t)(((1u << bottom) - 1) & ~((1u << top) - 1));
+
+    // Bit 0 of this tile row is bitmap row `srcY`, so each byte is made of the end of one bitmap row and the
+    // start of the next. srcY can be down to -7, the +8 keeps the division and modulo rounding down
+    int srcY = tileRow * 8 - y;
+    int srcRow = (srcY + 8) / 8 - 1;
+    int shift = (srcY + 8) % 8;
+    const uint8_t *upper = srcRow >= 0 ? data + srcRow * w + (x0 - x) : NULL;
+    const uint8_t *lower = shift != 0 && srcRow + 1 < srcRows ? data + (srcRow + 1) * w + (x0 - x) : NULL;
+    uint8_t *dst = buf + (tileRow - u->tile_curr_row) * rowBytes + x0;
+
+    if (shift == 0 && mask == 0xff && solid) {
+      // Aligned with the tiles: a straight copy
+      if (progmem) memcpy_P(dst, upper, x1 - x0);
+      else memcpy(dst, upper, x1 - x0);
+      continue;
+    }
+    for (int i = 0; i < x1 - x0; i++) {
+      uint8_t bits = 0;
+      if (upper != NULL) bits = (progmem ? u8x8_pgm_read(upper + i) : upper[i]) >> shift;
+      if (lower != NULL) bits |= (progmem ? u8x8_pgm_read(lower + i) : lower[i]) << (8 - shift);
+      dst[i] = solid ? (uint8_t)((dst[i] & ~mask) | (bits & mask)) : (uint8_t)(dst[i] | (bits & mask));
+    }
+  }
+}
+
+void PixelView::drawTileBitmap(int x, int y, const TileBitmap &bitmap) {
+  blitTiles(x, y, bitmap.width, bitmap.height, bitmap.data, true);
+}
+
+void PixelView::convertXBM(uint8_t width, uint8_t height, const uint8_t *xbm, uint8_t *tiles) {
+  int xbmRowBytes = (width + 7) / 8;
+  memset(tiles, 0, TileBitmap::bytesFor(width, height));
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      if (u8x8_pgm_read(xbm + y * xbmRowBytes + x / 8) & (1 << (x & 7))) tiles[(y / 8) * width + x] |= 1 << (y & 7);
+    }
+  }
+}
+
+bool PixelView::setIconCache(size_t slots) {
+  free(iconCache);
+  iconCache = NULL;
+  iconSlots = 0;
+  if (slots == 0) return true;
+
+  iconCache = (IconSlot *)calloc(slots, sizeof(IconSlot));
+  if (iconCache == NULL) return false;
+  iconSlots = slots;
+  return true;
+}
+
+void PixelView::decodeIcon(uint8_t width, uint8_t height, const uint8_t *icon, uint8_t *tiles) {
+  if (!PackedBitmap::isPacked(icon)) {
+    convertXBM(width, height, icon, tiles);
+    return;
+  }
+  PackedBitmap bitmap(icon);
+  if (bitmap.width() == width && bitmap.height() == height) bitmap.decode(tiles);
+  else memset(tiles, 0, TileBitmap::bytesFor(width, height));
+}
+
+void PixelView::drawPackedBitmap(int x, int y, const uint8_t *packed) {
+  PackedBitmap bitmap(packed);
+  uint8_t chunk[32];
+  for (int row = 0; row * 8 < bitmap.height(); row++) {
+    int h = std::min(8, bitmap.height() - row * 8);
+    for (int col = 0; col < bitmap.width(); col += sizeof(chunk)) {
+      int w = std::min<int>(sizeof(chunk), bitmap.width() - col);
+      bitmap.read(chunk, w);
+      blitTiles(x + col, y + row * 8, w, h, chunk, false);
+    }
+  }
+}
+
+void PixelView::drawIcon(int x, int y, uint8_t w, uint8_t h, const uint8_t *xbm) {
+  drawCachedIcon(x, y, w, h, xbm, false, 0);
+}
+
+void PixelView::drawCachedIcon(int x, int y, uint8_t w, uint8_t h, const uint8_t *xbm, bool streamed, size_t index) {
+  bool packed = PackedBitmap::isPacked(xbm);
+  if (packed) {
+    PackedBitmap bitmap(xbm);
+    w = bitmap.width();
+    h = bitmap.height();
+  }
+  if (iconCache == NULL || TileBitmap::bytesFor(w, h) > sizeof(iconCache[0].tiles)) {
+    if (packed) drawPackedBitmap(x, y, xbm);
+    else u8g2->drawXBMP(x, y, w, h, xbm);
+    return;
+  }
+
+  IconSlot *slot = NULL;
+  for (size_t i = 0; i < iconSlots && slot == NULL; i++) {
+    IconSlot &s = iconCache[i];
+    if (s.streamed != streamed || s.width != w || s.height != h) continue;
+    if (streamed ? s.index == index : s.xbm == xbm) slot = &s;
+  }
+  if (slot == NULL) {
+    // Replace the least recently used icon (empty slots have never been used)
+    slot = &iconCache[0];
+    for (size_t i = 1; i < iconSlots; i++) {
+      if (iconCache[i].lastUsed < slot->lastUsed) slot = &iconCache[i];
+    }
+    slot->xbm = xbm;
+    slot->index = index;
+    slot->streamed = streamed;
+    slot->width = w;
+    slot->height = h;
+    decodeIcon(w, h, xbm, slot->tiles);
+  }
+  slot->lastUsed = ++iconClock;
+  blitTiles(x, y, w, h, slot->tiles, false);
+}
+
+void PixelView::forgetStreamedIcons() {
+  for (size_t i = 0; i < iconSlots; i++) {
+    if (iconCache[i].streamed) iconCache[i] = IconSlot();
+  }
+}
+
+void PixelView::flushRegion(const Region &region) {
+  if (prefetching) return;
+  int x0 = std::max<int>(0, region.x);
+  int y0 = std::max<int>(0, region.y);
+  int x1 = std::min<int>(u8g2->getDisplayWidth(), region.x + region.w);
+  int y1 = std::min<int>(u8g2->getDisplayHeight(), region.y + region.h);
+  if (x1 <= x0 || y1 <= y0) return;
+  if (idle != NULL && !idle->regionReady()) return;
+
+  // Expand to whole 8x8 tiles, the smallest unit the controller can be sent
+  int tx = x0 / 8;
+  int ty = y0 / 8;
+  mirrorTiles(tx, ty, (x1 + 7) / 8 - tx, (y1 + 7) / 8 - ty);
+  if (flusher != NULL) flusher->submit(tx, ty, (x1 + 7) / 8 - tx, (y1 + 7) / 8 - ty);
+  else u8g2->updateDisplayArea(tx, ty, (x1 + 7) / 8 - tx, (y1 + 7) / 8 - ty);
+  sent((x1 + 7) / 8 - tx, (y1 + 7) / 8 - ty, false);
+}
+
+bool PixelView::isPageBuffered() { return u8g2->getBufferTileHeight() * 8 < u8g2->getDisplayHeight(); }
+
+PixelView::DrawState PixelView::saveDrawState() {
+  u8g2_t *u = u8g2->getU8g2();
+  return {u->font, u->draw_color, u->bitmap_transparency};
+}
+
+void PixelView::restoreDrawState(const DrawState &state) {
+  if (state.font != NULL) u8g2->setFont(state.font);
+  u8g2->setDrawColor(state.drawColor);
+  u8g2->setBitmapMode(state.bitmapMode);
+}
+
+void PixelView::sendPageRegion(const Region &region) {
+  int x0 = std::max<int>(0, region.x);
+  int y0 = std::max<int>(0, region.y);
+  int x1 = std::min<int>(u8g2->getDisplayWidth(), region.x + region.w);
+  int y1 = std::min<int>(u8g2->getDisplayHeight(), region.y + region.h);
+  if (x1 <= x0 || y1 <= y0) return;
+
+  int tx = x0 / 8;
+  int tw = (x1 + 7) / 8 - tx;
+  int firstRow = u8g2->getBufferCurrTileRow();
+  int rowBytes = u8g2->getBufferTileWidth() * 8;
+
+  // updateDisplayArea() is a no-op with page buffers, so the tiles are written through u8x8 directly
+  for (int r = 0; r < u8g2->getBufferTileHeight(); r++) {
+    int ty = firstRow + r;
+    if (ty < y0 / 8 || ty > (y1 - 1) / 8) continue;
+    u8x8_DrawTile(u8g2->getU8x8(), tx, ty, tw, u8g2->getBufferPtr() + r * rowBytes + tx * 8);
+    mirrorTiles(tx, ty, tw, 1);
+  }
+}
+
 bool PixelView::confirmYN(const char *message, bool defaultOption) {
   while (this->doInput() != ActionType::NONE)
     ;
 
   while (true) {
     auto render = [defaultOption, message, this]() {
-      u8g2->clearBuffer();
-
-      u8g2->setFont(font);
-      this->wordWrap(2, 12, message);
+      drawFrame([&] {
+        u8g2->setFont(fonts.mono);
+        this->wordWrap(2, 12, message);
 
-      if (defaultOption) {
-        u8g2->drawButtonUTF8(42, 50, U8G2_BTN_INV | U8G2_BTN_SHADOW2 | U8G2_BTN_HCENTER | U8G2_BTN_BW1, 0, 2, 2, "Yes");
+        if (defaultOption) {
+          u8g2->drawButtonUTF8(Geometry::YES_X, Geometry::BUTTON_Y,
+                               U8G2_BTN_INV | U8G2_BTN_SHADOW2 | U8G2_BTN_HCENTER | U8G2_BTN_BW1, 0, 2, 2, "Yes");
 
-        u8g2->drawButtonUTF8(84, 50, U8G2_BTN_SHADOW2 | U8G2_BTN_HCENTER | U8G2_BTN_BW1, 0, 2, 2, "No");
-      } else {
-        u8g2->drawButtonUTF8(42, 50, U8G2_BTN_SHADOW2 | U8G2_BTN_HCENTER | U8G2_BTN_BW1, 0, 2, 2, "Yes");
+          u8g2->drawButtonUTF8(Geometry::NO_X, Geometry::BUTTON_Y, U8G2_BTN_SHADOW2 | U8G2_BTN_HCENTER | U8G2_BTN_BW1,
+                               0, 2, 2, "No");
+        } else {
+          u8g2->drawButtonUTF8(Geometry::YES_X, Geometry::BUTTON_Y, U8G2_BTN_SHADOW2 | U8G2_BTN_HCENTER | U8G2_BTN_BW1,
+                               0, 2, 2, "Yes");
 
-        u8g2->drawButtonUTF8(84, 50, U8G2_BTN_INV | U8G2_BTN_SHADOW2 | U8G2_BTN_HCENTER | U8G2_BTN_BW1, 0, 2, 2, "No");
-      }
-      u8g2->sendBuffer();
+          u8g2->drawButtonUTF8(Geometry::NO_X, Geometry::BUTTON_Y,
+                               U8G2_BTN_INV | U8G2_BTN_SHADOW2 | U8G2_BTN_HCENTER | U8G2_BTN_BW1, 0, 2, 2, "No");
+        }
+      });
     };
     auto render2 = [defaultOption, message, this]() {
-      u8g2->clearBuffer();
-
-      u8g2->setFont(font);
-      this->wordWrap(2, 12, message);
-      if (defaultOption) {
-        u8g2->drawButtonUTF8(45, 53, U8G2_BTN_INV | U8G2_BTN_HCENTER | U8G2_BTN_BW1, 0, 2, 2, "Yes");
-
-        u8g2->drawButtonUTF8(84, 50, U8G2_BTN_SHADOW2 | U8G2_BTN_HCENTER | U8G2_BTN_BW1, 0, 2, 2, "No");
-      } else {
-        u8g2->drawButtonUTF8(42, 50, U8G2_BTN_SHADOW2 | U8G2_BTN_HCENTER | U8G2_BTN_BW1, 0, 2, 2, "Yes");
+      drawFrame([&] {
+        u8g2->setFont(fonts.mono);
+        this->wordWrap(2, 12, message);
+        if (defaultOption) {
+          u8g2->drawButtonUTF8(Geometry::YES_X + 3, Geometry::BUTTON_Y + 3,
+                               U8G2_BTN_INV | U8G2_BTN_HCENTER | U8G2_BTN_BW1, 0, 2, 2, "Yes");
+
+          u8g2->drawButtonUTF8(Geometry::NO_X, Geometry::BUTTON_Y, U8G2_BTN_SHADOW2 | U8G2_BTN_HCENTER | U8G2_BTN_BW1,
+                               0, 2, 2, "No");
+        } else {
+          u8g2->drawButtonUTF8(Geometry::YES_X, Geometry::BUTTON_Y, U8G2_BTN_SHADOW2 | U8G2_BTN_HCENTER | U8G2_BTN_BW1,
+                               0, 2, 2, "Yes");
 
-        u8g2->drawButtonUTF8(87, 53, U8G2_BTN_INV | U8G2_BTN_HCENTER | U8G2_BTN_BW1, 0, 2, 2, "No");
-      }
-      u8g2->sendBuffer();
+          u8g2->drawButtonUTF8(Geometry::NO_X + 3, Geometry::BUTTON_Y + 3,
+                               U8G2_BTN_INV | U8G2_BTN_HCENTER | U8G2_BTN_BW1, 0, 2, 2, "No");
+        }
+      });
     };
     render();
 
@@ -168,192 +700,197 @@ void PixelView::showMessage(const char *message) {
     this->doDelay(20);
   }
 
-  u8g2->clearBuffer();
-
-  u8g2->setFont(font);
-  this->wordWrap(2, 12, message);
-  u8g2->drawButtonUTF8(58, 56, U8G2_BTN_INV | U8G2_BTN_SHADOW2 | U8G2_BTN_HCENTER | U8G2_BTN_BW1, 0, 2, 2, "Okay");
-
-  u8g2->sendBuffer();
+  drawFrame([&] {
+    u8g2->setFont(fonts.mono);
+    this->wordWrap(2, 12, message);
+    u8g2->drawButtonUTF8(Geometry::OKAY_X, Geometry::OKAY_Y,
+                         U8G2_BTN_INV | U8G2_BTN_SHADOW2 | U8G2_BTN_HCENTER | U8G2_BTN_BW1, 0, 2, 2, "Okay");
+  });
   while (doInput() != ActionType::SEL) {
     this->doDelay(20);
   }
 
-  u8g2->clearBuffer();
-  u8g2->setFont(font);
-  this->wordWrap(2, 12, message);
-  u8g2->drawButtonUTF8(61, 59, U8G2_BTN_INV | U8G2_BTN_HCENTER | U8G2_BTN_BW1, 0, 2, 2, "Okay");
-
-  u8g2->sendBuffer();
+  drawFrame([&] {
+    u8g2->setFont(fonts.mono);
+    this->wordWrap(2, 12, message);
+    u8g2->drawButtonUTF8(Geometry::OKAY_X + 3, Geometry::OKAY_Y + 3, U8G2_BTN_INV | U8G2_BTN_HCENTER | U8G2_BTN_BW1, 0,
+                         2, 2, "Okay");
+  });
 
   this->doDelay(150);
   while (doInput() != ActionType::NONE) {
     doDelay(20);
   }
 
-  u8g2->clearBuffer();
-  u8g2->setFont(font);
-  this->wordWrap(2, 12, message);
-  u8g2->drawButtonUTF8(58, 56, U8G2_BTN_INV | U8G2_BTN_SHADOW2 | U8G2_BTN_HCENTER | U8G2_BTN_BW1, 0, 2, 2, "Okay");
-  u8g2->sendBuffer();
+  drawFrame([&] {
+    u8g2->setFont(fonts.mono);
+    this->wordWrap(2, 12, message);
+    u8g2->drawButtonUTF8(Geometry::OKAY_X, Geometry::OKAY_Y,
+                         U8G2_BTN_INV | U8G2_BTN_SHADOW2 | U8G2_BTN_HCENTER | U8G2_BTN_BW1, 0, 2, 2, "Okay");
+  });
   this->doDelay(50);
 }
 
+void PixelView::showText(const char *message) {
+  drawFrame([&] {
+    u8g2->setFont(fonts.mono);
+    this->wordWrap(2, 12, message);
+  });
+}
+
 PixelView::Keyboard::Keyboard(PixelView *pixelView) : caps(false), insertIdx(0), p(pixelView), currentLayer(letters) {}
 
 void PixelView::Keyboard::renderKeyboard(int pX, int pY, const String &text) {
-  this->p->u8g2->clearBuffer();
-
-  // Draw grid lines
-  for (int i = 9; i <= 51; i += 14) {
-    this->p->u8g2->drawLine(0, i, 128, i);
-  }
-  for (int i = 15; i <= 120; i += 12) {
-    this->p->u8g2->drawLine(i, 9, i, 64);
+  String displayText = text;
+  if (text.length() > 19) {
+    displayText = displayText.substring(text.length() - 19, text.length());
   }
 
-  // Render keys
-  for (int i = 0; i < 4; i++) {
-    for (int j = 0; j < 10; j++) {
-      int x = j * 12 + 7;
-      int y = i * 14 + 18 + 2;
-
-      this->p->u8g2->setFont(u8g2_font_6x13_me);
+  this->p->drawFrame([&] {
+    // Draw grid lines
+    for (int i = 9; i <= 51; i += 14) {
+      this->p->u8g2->drawLine(0, i, Geometry::WIDTH, i);
+    }
+    for (int i = 15; i <= 120; i += 12) {
+      this->p->u8g2->drawLine(i, 9, i, Geometry::HEIGHT);
+    }
 
-      if (strcmp(currentLayer[i][j], "<caps>") == 0) {
-        if (caps || (j == pX && i == pY)) {
-          this->p->u8g2->setFont(u8g2_font_6x12_t_symbols);
-          this->p->u8g2->drawButtonUTF8(x, y, U8G2_BTN_INV, 0, 1, 1, "⇑");
-        } else {
-          this->p->u8g2->setFont(u8g2_font_6x12_t_symbols);
-          this->p->u8g2->drawUTF8(x, y, "⇑");
+    // Render keys
+    for (int i = 0; i < 4; i++) {
+      for (int j = 0; j < 10; j++) {
+        int x = j * 12 + 7;
+        int y = i * 14 + 18 + 2;
+
+        this->p->u8g2->setFont(this->p->fonts.keys);
+
+        if (strcmp(currentLayer[i][j], "<caps>") == 0) {
+          if (caps || (j == pX && i == pY)) {
+            this->p->u8g2->setFont(this->p->fonts.keySymbols);
+            this->p->u8g2->drawButtonUTF8(x, y, U8G2_BTN_INV, 0, 1, 1, "⇑");
+          } else {
+            this->p->u8g2->setFont(this->p->fonts.keySymbols);
+            this->p->u8g2->drawUTF8(x, y, "⇑");
+          }
+          continue;
         }
-        continue;
-      }
 
-      if (strcmp(currentLayer[i][j], "<rm>") == 0) {
-        if (j == pX && i == pY) {
-          this->p->u8g2->setFont(u8g2_font_6x12_t_symbols);
-          this->p->u8g2->drawButtonUTF8(x, y, U8G2_BTN_INV, 0, 1, 1, "⇐");
-        } else {
-          this->p->u8g2->setFont(u8g2_font_6x12_t_symbols);
-          this->p->u8g2->drawUTF8(x, y, "⇐");
+        if (strcmp(currentLayer[i][j], "<rm>") == 0) {
+          if (j == pX && i == pY) {
+            this->p->u8g2->setFont(this->p->fonts.keySymbols);
+            this->p->u8g2->drawButtonUTF8(x, y, U8G2_BTN_INV, 0, 1, 1, "⇐");
+          } else {
+            this->p->u8g2->setFont(this->p->fonts.keySymbols);
+            this->p->u8g2->drawUTF8(x, y, "⇐");
+          }
+          continue;
         }
-        continue;
-      }
 
-      if (strcmp(currentLayer[i][j], "<sym1>") == 0) {
-        if (j == pX && i == pY) {
-          this->p->u8g2->setFont(u8g2_font_6x12_t_symbols);
-          this->p->u8g2->drawButtonUTF8(x, y, U8G2_BTN_INV, 0, 1, 1, "#");
-        } else {
-          this->p->u8g2->setFont(u8g2_font_6x12_t_symbols);
-          this->p->u8g2->drawUTF8(x, y, "#");
+        if (strcmp(currentLayer[i][j], "<sym1>") == 0) {
+          if (j == pX && i == pY) {
+            this->p->u8g2->setFont(this->p->fonts.keySymbols);
+            this->p->u8g2->drawButtonUTF8(x, y, U8G2_BTN_INV, 0, 1, 1, "#");
+          } else {
+            this->p->u8g2->setFont(this->p->fonts.keySymbols);
+            this->p->u8g2->drawUTF8(x, y, "#");
+          }
+          continue;
         }
-        continue;
-      }
 
-      if (strcmp(currentLayer[i][j], "<sym2>") == 0) {
-        if (j == pX && i == pY) {
-          this->p->u8g2->setFont(u8g2_font_6x12_t_symbols);
-          this->p->u8g2->drawButtonUTF8(x, y, U8G2_BTN_INV, 0, 1, 1, "¬");
-        } else {
-          this->p->u8g2->setFont(u8g2_font_6x12_t_symbols);
-          this->p->u8g2->drawUTF8(x, y, "¬");
+        if (strcmp(currentLayer[i][j], "<sym2>") == 0) {
+          if (j == pX && i == pY) {
+            this->p->u8g2->setFont(this->p->fonts.keySymbols);
+            this->p->u8g2->drawButtonUTF8(x, y, U8G2_BTN_INV, 0, 1, 1, "¬");
+          } else {
+            this->p->u8g2->setFont(this->p->fonts.keySymbols);
+            this->p->u8g2->drawUTF8(x, y, "¬");
+          }
+          continue;
         }
-        continue;
-      }
 
-      if (strcmp(currentLayer[i][j], "<let>") == 0) {
-        if (j == pX && i == pY) {
-          this->p->u8g2->setFont(u8g2_font_6x12_tr);
-          this->p->u8g2->drawButtonUTF8(x, y, U8G2_BTN_INV, 0, 1, 1, "A");
-        } else {
-          this->p->u8g2->setFont(u8g2_font_6x12_t_symbols);
-          this->p->u8g2->drawUTF8(x, y, "A");
+        if (strcmp(currentLayer[i][j], "<let>") == 0) {
+          if (j == pX && i == pY) {
+            this->p->u8g2->setFont(this->p->fonts.mono);
+            this->p->u8g2->drawButtonUTF8(x, y, U8G2_BTN_INV, 0, 1, 1, "A");
+          } else {
+            this->p->u8g2->setFont(this->p->fonts.keySymbols);
+            this->p->u8g2->drawUTF8(x, y, "A");
+          }
+          continue;
         }
-        continue;
-      }
-      if (strcmp(currentLayer[i][j], "<ques>") == 0) {
-        if (j == pX && i == pY) {
-          this->p->u8g2->setFont(u8g2_font_6x12_tr);
-          this->p->u8g2->drawButtonUTF8(x, y, U8G2_BTN_INV, 0, 1, 1, "?");
-        } else {
-          this->p->u8g2->setFont(u8g2_font_6x12_t_symbols);
-          this->p->u8g2->drawUTF8(x, y, "?");
+        if (strcmp(currentLayer[i][j], "<ques>") == 0) {
+          if (j == pX && i == pY) {
+            this->p->u8g2->setFont(this->p->fonts.mono);
+            this->p->u8g2->drawButtonUTF8(x, y, U8G2_BTN_INV, 0, 1, 1, "?");
+          } else {
+            this->p->u8g2->setFont(this->p->fonts.keySymbols);
+            this->p->u8g2->drawUTF8(x, y, "?");
+          }
+          continue;
         }
-        continue;
-      }
-      if (strcmp(currentLayer[i][j], "<ok>") == 0) {
-        if (j == pX && i == pY) {
-          this->p->u8g2->setFont(u8g2_font_6x12_t_symbols);
-          this->p->u8g2->drawButtonUTF8(x, y, U8G2_BTN_INV, 0, 1, 1, "✓");
-        } else {
-          this->p->u8g2->setFont(u8g2_font_6x12_t_symbols);
-          this->p->u8g2->drawUTF8(x, y, "✓");
+        if (strcmp(currentLayer[i][j], "<ok>") == 0) {
+          if (j == pX && i == pY) {
+            this->p->u8g2->setFont(this->p->fonts.keySymbols);
+            this->p->u8g2->drawButtonUTF8(x, y, U8G2_BTN_INV, 0, 1, 1, "✓");
+          } else {
+            this->p->u8g2->setFont(this->p->fonts.keySymbols);
+            this->p->u8g2->drawUTF8(x, y, "✓");
+          }
+          continue;
         }
-        continue;
-      }
-      if (strcmp(currentLayer[i][j], "<clr>") == 0) {
-        if (j == pX && i == pY) {
-          this->p->u8g2->setFont(u8g2_font_6x12_t_symbols);
-          this->p->u8g2->drawButtonUTF8(x, y, U8G2_BTN_INV, 0, 1, 1, "✕");
-        } else {
-          this->p->u8g2->setFont(u8g2_font_6x12_t_symbols);
-          this->p->u8g2->drawUTF8(x, y, "✕");
+        if (strcmp(currentLayer[i][j], "<clr>") == 0) {
+          if (j == pX && i == pY) {
+            this->p->u8g2->setFont(this->p->fonts.keySymbols);
+            this->p->u8g2->drawButtonUTF8(x, y, U8G2_BTN_INV, 0, 1, 1, "✕");
+          } else {
+            this->p->u8g2->setFont(this->p->fonts.keySymbols);
+            this->p->u8g2->drawUTF8(x, y, "✕");
+          }
+          continue;
         }
-        continue;
-      }
-      if (strcmp(currentLayer[i][j], "<rev>") == 0) {
-        if (j == pX && i == pY) {
-          this->p->u8g2->setFont(u8g2_font_6x12_t_symbols);
-          this->p->u8g2->drawButtonUTF8(x, y, U8G2_BTN_INV, 0, 1, 1, "©");
-        } else {
-          this->p->u8g2->setFont(u8g2_font_6x12_t_symbols);
-          this->p->u8g2->drawUTF8(x, y, "©");
+        if (strcmp(currentLayer[i][j], "<rev>") == 0) {
+          if (j == pX && i == pY) {
+            this->p->u8g2->setFont(this->p->fonts.keySymbols);
+            this->p->u8g2->drawButtonUTF8(x, y, U8G2_BTN_INV, 0, 1, 1, "©");
+          } else {
+            this->p->u8g2->setFont(this->p->fonts.keySymbols);
+            this->p->u8g2->drawUTF8(x, y, "©");
+          }
+          continue;
         }
-        continue;
-      }
-      if (strcmp(currentLayer[i][j], "<left>") == 0) {
-        if (j == pX && i == pY) {
-          this->p->u8g2->setFont(u8g2_font_6x12_t_symbols);
-          this->p->u8g2->drawButtonUTF8(x, y, U8G2_BTN_INV, 0, 1, 1, "←");
-        } else {
-          this->p->u8g2->setFont(u8g2_font_6x12_t_symbols);
-          this->p->u8g2->drawUTF8(x, y, "←");
+        if (strcmp(currentLayer[i][j], "<left>") == 0) {
+          if (j == pX && i == pY) {
+            this->p->u8g2->setFont(this->p->fonts.keySymbols);
+            this->p->u8g2->drawButtonUTF8(x, y, U8G2_BTN_INV, 0, 1, 1, "←");
+          } else {
+            this->p->u8g2->setFont(this->p->fonts.keySymbols);
+            this->p->u8g2->drawUTF8(x, y, "←");
+          }
+          continue;
         }
-        continue;
-      }
-      if (strcmp(currentLayer[i][j], "<right>") == 0) {
-        if (j == pX && i == pY) {
-          this->p->u8g2->setFont(u8g2_font_6x12_t_symbols);
-          this->p->u8g2->drawButtonUTF8(x, y, U8G2_BTN_INV, 0, 1, 1, "→");
-        } else {
-          this->p->u8g2->setFont(u8g2_font_6x12_t_symbols);
-          this->p->u8g2->drawUTF8(x, y, "→");
+        if (strcmp(currentLayer[i][j], "<right>") == 0) {
+          if (j == pX && i == pY) {
+            this->p->u8g2->setFont(this->p->fonts.keySymbols);
+            this->p->u8g2->drawButtonUTF8(x, y, U8G2_BTN_INV, 0, 1, 1, "→");
+          } else {
+            this->p->u8g2->setFont(this->p->fonts.keySymbols);
+            this->p->u8g2->drawUTF8(x, y, "→");
+          }
+          continue;
         }
-        continue;
-      }
 
-      // Draw character
-      if (j == pX && i == pY) this->p->u8g2->drawButtonUTF8(x, y, U8G2_BTN_INV, 0, 1, 1, currentLayer[i][j]);
-      else this->p->u8g2->drawStr(x, y, currentLayer[i][j]);
+        // Draw character
+        if (j == pX && i == pY) this->p->u8g2->drawButtonUTF8(x, y, U8G2_BTN_INV, 0, 1, 1, currentLayer[i][j]);
+        else this->p->u8g2->drawStr(x, y, currentLayer[i][j]);
+      }
     }
-  }
-
-  String displayText = text;
-  if (text.length() > 19) {
-    displayText = displayText.substring(text.length() - 19, text.length());
-  }
 
-  this->p->u8g2->setFont(this->p->font);
-  this->p->u8g2->drawStr(2, 7, displayText.c_str());
+    this->p->u8g2->setFont(this->p->fonts.mono);
+    this->p->u8g2->drawStr(2, 7, displayText.c_str());
 
-  // int cursorX = (u8g2->getMaxCharWidth() * displayText.length()) + 2;
-  int cursorX = (this->p->u8g2->getUTF8Width(displayText.c_str()) + 4);
-  this->p->u8g2->drawVLine(cursorX, 0, 8);
-
-  this->p->u8g2->sendBuffer();
+    // int cursorX = (u8g2->getMaxCharWidth() * displayText.length()) + 2;
+    int cursorX = (this->p->u8g2->getUTF8Width(displayText.c_str()) + 4);
+    this->p->u8g2->drawVLine(cursorX, 0, 8);
+  });
 }
 
 String PixelView::Keyboard::numPad(const String message, bool isEmptyAllowed, const char *defaultText) {
@@ -373,22 +910,22 @@ String PixelView::Keyboard::numPad(const String message, bool isEmptyAllowed, co
    */
 
   while (true) {
-    p->u8g2->clearBuffer();
-    p->u8g2->setBitmapMode(1);
-    p->u8g2->setFont(u8g2_font_profont12_tf);
-    for (int i = 0; i <= 3; i++) {
-      for (int j = 0; j <= 2; j++) {
-        p->u8g2->drawUTF8((j + 1) * 12 - 4, (i + 1) * 12 + 7, numpad[i][j]);
+    p->drawFrame([&] {
+      p->u8g2->setBitmapMode(1);
+      p->u8g2->setFont(p->fonts.numpad);
+      for (int i = 0; i <= 3; i++) {
+        for (int j = 0; j <= 2; j++) {
+          p->u8g2->drawUTF8((j + 1) * 12 - 4, (i + 1) * 12 + 7, numpad[i][j]);
+        }
       }
-    }
 
-    p->u8g2->drawRFrame(4, 8, 37, 50, 0);
-    p->u8g2->setFont(u8g2_font_haxrcorp4089_tr);
-    this->p->wordWrap(50, 21, text.c_str(), true);
+      p->u8g2->drawRFrame(4, 8, 37, 50, 0);
+      p->u8g2->setFont(p->fonts.small);
+      this->p->wordWrap(50, 21, text.c_str(), true);
 
-    p->u8g2->setDrawColor(2);
-    p->u8g2->drawBox((indexX + 1) * 12 - 4 - 2, ((indexY + 1) * 12 + 7 - 9), 9, 10);
-    p->u8g2->sendBuffer();
+      p->u8g2->setDrawColor(2);
+      p->u8g2->drawBox((indexX + 1) * 12 - 4 - 2, ((indexY + 1) * 12 + 7 - 9), 9, 10);
+    });
 
     ActionType action = p->doInput();
     if (action == ActionType::UP) {
@@ -522,10 +1059,10 @@ String PixelView::Keyboard::fullKeyboard(const String &message, bool isEmptyAllo
 
       if (strcmp(currentLayer[pointerY][pointerX], "<rev>") == 0) {
         // Preview the current text
-        p->u8g2->clearBuffer();
-        p->u8g2->setFont(u8g2_font_6x12_tr);
-        p->wordWrap(2, 7, text.length() == 0 ? "No text input" : text.c_str());
-        p->u8g2->sendBuffer();
+        p->drawFrame([&] {
+          p->u8g2->setFont(p->fonts.mono);
+          p->wordWrap(2, 7, text.length() == 0 ? "No text input" : text.c_str());
+        });
 
         while (p->doInput() != ActionType::SEL) {
           p->doDelay(20);
@@ -575,30 +1112,256 @@ PixelView::Pager::Pager(PixelView *px, const size_t numPages, PixelView::Pager::
   this->numPages = numPages;
   this->pages = pages;
   this->indicator = indicatorType;
+  indicatorText[0] = '\0';
+}
+
+PixelView::Pager::~Pager() { setPrefetch(false); }
+
+size_t PixelView::Pager::adjacentPage(size_t from, bool forward) const {
+  size_t i = from;
+  do {
+    if (forward) i = (i + 1) % numPages;
+    else i = (i == 0) ? numPages - 1 : i - 1;
+  } while (!pages[i].enabled && i != from);
+
+  return i;
+}
+
+bool PixelView::Pager::selectPage(bool forward) {
+  index = adjacentPage(index, forward);
+  return pages[index].enabled;
+}
+
+bool PixelView::Pager::setPrefetch(bool enabled) {
+  for (PrefetchSlot &slot : prefetchSlots) {
+    free(slot.buffer);
+    slot = PrefetchSlot();
+  }
+  prefetchBufferSize = 0;
+  if (!enabled) return true;
+
+  // Page buffer displays render a frame in several passes, there is no whole frame to keep
+  if (px->u8g2->getBufferTileHeight() * 8 < px->u8g2->getDisplayHeight()) return false;
+
+  size_t size = (size_t)px->u8g2->getBufferTileWidth() * px->u8g2->getBufferTileHeight() * 8;
+  for (PrefetchSlot &slot : prefetchSlots) {
+    slot.buffer = (uint8_t *)malloc(size);
+    if (slot.buffer == NULL) {
+      setPrefetch(false);
+      return false;
+    }
+  }
+  prefetchBufferSize = size;
+  return true;
+}
+
+PixelView::Pager::PrefetchSlot *PixelView::Pager::findPrefetched(size_t page, unsigned long now) {
+  if (prefetchBufferSize == 0 || pages[page].dirty || pages[page].isVolatile) return NULL;
+
+  for (PrefetchSlot &slot : prefetchSlots) {
+    if (slot.valid && slot.page == page) {
+      unsigned long maxAge = pages[page].maxAgeMS != 0 ? pages[page].maxAgeMS : prefetchMaxAgeMS;
+      if (maxAge != 0 && now - slot.renderedMS > maxAge) return NULL;
+      return &slot;
+    }
+  }
+  return NULL;
+}
+
+bool PixelView::Pager::prefetchTick(unsigned long now) {
+  if (prefetchBufferSize == 0) return false;
+
+  const size_t targets[2] = {adjacentPage(index, true), adjacentPage(index, false)};
+
+  for (size_t target : targets) {
+    Page &page = pages[target];
+    if (target == index || !page.enabled || page.isVolatile || findPrefetched(target, now)) continue;
+
+    // Reuse the slot holding this page, otherwise one that holds neither neighbour
+    PrefetchSlot *slot = NULL;
+    for (PrefetchSlot &s : prefetchSlots) {
+      if (s.valid && s.page == target) slot = &s;
+    }
+    for (PrefetchSlot &s : prefetchSlots) {
+      if (slot == NULL && (!s.valid || (s.page != targets[0] && s.page != targets[1]))) slot = &s;
+    }
+    if (slot == NULL) continue;
+
+    // Point U8g2 at the off-screen buffer for the duration of the render. Nothing drawn into it may reach the
+    // display, so what the renderer sends (a BoundWidget's update(), a widget's frame) is dropped meanwhile
+    u8g2_t *u = px->u8g2->getU8g2();
+    uint8_t *displayBuffer = u->tile_buf_ptr;
+    u->tile_buf_ptr = slot->buffer;
+    px->prefetching = true;
+    px->u8g2->clearBuffer();
+    slot->action = page.renderer(this->px->u8g2, this->px, this->pages, this->numPages);
+    px->prefetching = false;
+    u->tile_buf_ptr = displayBuffer;
+
+    slot->page = target;
+    slot->valid = true;
+    slot->renderedMS = now;
+    page.dirty = false;
+
+    // One page per tick keeps poll() short
+    return true;
+  }
+  return false;
+}
+
+void PixelView::Pager::layoutIndicator(size_t currentEnabledIndex, size_t enabledCount) {
+  indicatorIndex = currentEnabledIndex;
+  indicatorCount = enabledCount;
+
+  char *p = indicatorText;
+  IndicatorType type = this->indicator;
+  if (type == IndicatorType::DOT) {
+    // One dot per page, as long as they fit in the text and on the display. More pages are shown as numbers
+    px->u8g2->setFont(px->fonts.dots);
+    const size_t dotBytes = sizeof("●") - 1;
+    size_t maxDots = std::min((sizeof(indicatorText) - 1) / dotBytes,
+                              (size_t)(Geometry::WIDTH / std::max(1, (int)px->u8g2->getUTF8Width("●"))));
+    if (enabledCount > maxDots) type = IndicatorType::NUM;
+  }
+  indicatorFont = type == IndicatorType::DOT ? px->fonts.dots : px->fonts.mono;
+
+  switch (type) {
+  case IndicatorType::DOT: {
+    for (size_t i = 1; i <= enabledCount; i++) {
+      p = StringUtils::appendStr(p, (i == currentEnabledIndex) ? "●" : "○");
+    }
+    break;
+  }
+  case IndicatorType::NUM: {
+    px->u8g2->setFont(px->fonts.mono);
+    p = StringUtils::appendUnsigned(p, currentEnabledIndex);
+    p = StringUtils::appendStr(p, " of ");
+    StringUtils::appendUnsigned(p, enabledCount);
+    break;
+  }
+  case IndicatorType::NUM_ARROW: {
+    px->u8g2->setFont(px->fonts.mono);
+    p = StringUtils::appendStr(p, "< ");
+    p = StringUtils::appendUnsigned(p, currentEnabledIndex);
+    p = StringUtils::appendStr(p, " of ");
+    p = StringUtils::appendUnsigned(p, enabledCount);
+    StringUtils::appendStr(p, " >");
+    break;
+  }
+  case IndicatorType::ARROW: {
+    px->u8g2->setFont(px->fonts.mono);
+    StringUtils::appendStr(p, "<      >");
+    break;
+  }
+  case IndicatorType::NONE:
+    *p = '\0';
+    break;
+  }
+
+  indicatorX = (Geometry::WIDTH - (px->u8g2->getUTF8Width(indicatorText))) / 2;
 }
 
+void PixelView::Pager::invalidate() { pages[index].dirty = true; }
+
 PixelView::Pager::PagerActionType PixelView::Pager::render() {
-  static bool navEnabled = true;
-  size_t originalIndex;
+  invalidate();
+  return poll();
+}
+
+PixelView::Pager::PagerActionType PixelView::Pager::poll() {
+  if (numPages == 0) return PagerActionType::CONTINUE;
 
   // Skip disabled pages when starting render
+  bool shown = false;
   if (!pages[index].enabled) {
-    // Find next enabled page
-    originalIndex = index;
-    do {
-      index = (index + 1) % numPages;
-    } while (!pages[index].enabled && index != originalIndex);
-
     // If we wrapped around and found no enabled pages, return
-    if (!pages[index].enabled) {
-      return PagerActionType::CONTINUE;
+    if (!selectPage(true)) return PagerActionType::CONTINUE;
+    shown = true;
+  }
+
+  // Input is acted upon on its leading edge, so a held button doesn't block or repeat
+  ActionType input = px->doInput();
+  bool pressed = input != ActionType::NONE && input != lastInput;
+  lastInput = input;
+
+  if (pressed && navEnabled) {
+    if ((input == ActionType::LEFT) || (input == ActionType::UP)) {
+      selectPage(false);
+      shown = true;
+      pressed = false;
+    } else if ((input == ActionType::RIGHT) || (input == ActionType::DOWN)) {
+      selectPage(true);
+      shown = true;
+      pressed = false;
+    }
+  }
+
+  Page &page = pages[index];
+
+  // Any other input may be read by the page itself, so give it a chance to react
+  if (pressed) page.dirty = true;
+
+  unsigned long now = millis();
+  if (page.refresh == Refresh::ANIMATED && !shown && now - lastFrameMS >= frameMS) page.dirty = true;
+
+  // Enabling/disabling pages from another page changes the indicator
+  size_t enabledCount = 0;
+  size_t currentEnabledIndex = 0;
+  for (size_t i = 0; i < numPages; i++) {
+    if (pages[i].enabled) {
+      enabledCount++;
+      if (i <= index) currentEnabledIndex = enabledCount;
     }
   }
+  bool indicatorChanged = enabledCount != indicatorCount || currentEnabledIndex != indicatorIndex;
+
+  // A new frame is needed when the content changed, or when the page or its indicator changed. In the
+  // latter case a pre-rendered frame of the page can be used
+  if (!page.dirty && !shown && !indicatorChanged) {
+    prefetchTick(now);
+    return PagerActionType::CONTINUE;
+  }
+
+  if (indicatorChanged) layoutIndicator(currentEnabledIndex, enabledCount);
+
+  PagerActionType returnVal = PagerActionType::CONTINUE;
+  PrefetchSlot *prefetched = findPrefetched(index, now);
+  if (prefetched != NULL) {
+    memcpy(px->u8g2->getBufferPtr(), prefetched->buffer, prefetchBufferSize);
+    lastFrameMS = prefetched->renderedMS;
+    returnVal = prefetched->action;
+    applyAction(returnVal);
+    drawIndicator();
+    if (px->idle == NULL || px->idle->frameReady(px->hashBuffer())) px->sendFrame();
+    return returnVal;
+  }
+
+  lastFrameMS = now;
+  page.dirty = false;
+
+  // A frame kept for this page is older than the one being rendered
+  for (PrefetchSlot &slot : prefetchSlots) {
+    if (slot.page == index) slot.valid = false;
+  }
+
+  bool firstPass = true;
+  px->drawFrame([&] {
+    PagerActionType action = page.renderer(this->px->u8g2, this->px, this->pages, this->numPages);
 
-  px->u8g2->clearBuffer();
-  PagerActionType returnVal = this->pages[index].renderer(this->px->u8g2, this->px, this->pages, this->numPages);
+    // With a page buffer the renderer runs once per page, only its first answer counts
+    if (firstPass) {
+      returnVal = action;
+      applyAction(action);
+      firstPass = false;
+    }
+    drawIndicator();
+  });
+
+  return returnVal;
+}
 
-  switch (returnVal) {
+void PixelView::Pager::applyAction(PagerActionType action) {
+  switch (action) {
   case PagerActionType::DISABLE_NAV: {
     navEnabled = false;
   } break;
@@ -618,135 +1381,519 @@ PixelView::Pager::PagerActionType PixelView::Pager::render() {
     //////////////////////////////////////////////////////////////////////////////////////////
   } break;
   }
+}
 
-  if (!navEnabled) {
-    px->u8g2->sendBuffer();
-    return returnVal;
+void PixelView::Pager::drawIndicator() {
+  if (!navEnabled || this->indicator == IndicatorType::NONE || indicatorFont == NULL) return; // Not laid out yet
+
+  px->u8g2->setFont(indicatorFont);
+  px->u8g2->drawUTF8(indicatorX, Geometry::HEIGHT, indicatorText);
+}
+
+void PixelView::Pager::loop(int delay) {
+  while (true) {
+    if (poll() == PagerActionType::EXIT) {
+      break;
+    }
+
+    this->px->doDelay(delay);
   }
+}
 
-  switch (this->indicator) {
-  case IndicatorType::DOT: {
-    px->u8g2->setFont(u8g2_font_unifont_t_75);
-    String str;
-    for (int i = 0; i < numPages; i++) {
-      if (pages[i].enabled) { // Only show dots for enabled pages
-        str += ((i == index) ? "●" : "○");
-      }
+bool PixelView::BoundWidget::update(bool flush) {
+  if (sample()) dirty = true;
+  if (!dirty) return false;
+
+  px->drawRegion(
+      region,
+      [this] {
+        px->u8g2->setClipWindow(region.x, region.y, region.x + region.w, region.y + region.h);
+        redraw();
+        px->u8g2->setMaxClipWindow();
+        px->u8g2->setDrawColor(1);
+      },
+      flush);
+  dirty = false;
+  return true;
+}
+
+void PixelView::BoundWidget::redraw() {
+  px->clearRegion(region);
+  draw(px->u8g2);
+}
+
+size_t PixelView::BoundWidget::updateAll(BoundWidget *widgets[], const size_t numWidgets, bool flush) {
+  size_t redrawn = 0;
+  for (size_t i = 0; i < numWidgets; i++) {
+    if (widgets[i]->update(flush)) redrawn++;
+  }
+  return redrawn;
+}
+
+PixelView::Readout::Readout(PixelView *px, Region region, BoundValue value, unsigned char decimals, float threshold,
+                            const char *label, const char *unit, const uint8_t *font)
+    : BoundWidget(px, region), value(value), decimals(decimals), threshold(threshold), label(label), unit(unit),
+      font(font) {}
+
+bool PixelView::Readout::sample() {
+  float v = value.get();
+  float delta = v > shown ? v - shown : shown - v;
+  if (delta < threshold) return false;
+
+  // Compare what would actually be printed, so sub-digit noise never causes a redraw
+  float scale = 1;
+  for (unsigned char i = 0; i < decimals; i++)
+    scale *= 10;
+  // lround() can't represent NaN, infinities or huge values: those are compared as they are
+  const float maxPrinted = 1e9f;
+  long printed = 0;
+  if (fabsf(v * scale) < maxPrinted) {
+    printed = lround(v * scale);
+    if (printed == shownPrinted && fabsf(shown * scale) < maxPrinted) return false;
+  } else if (v == shown || (isnan(v) && isnan(shown))) {
+    return false;
+  }
+
+  shown = v;
+  shownPrinted = printed;
+  return true;
+}
+
+void PixelView::Readout::draw(U8G2 *disp) {
+  // A long label or unit is cut off rather than overflowing: it wouldn't fit on the display anyway
+  char number[StringUtils::MAX_FIXED_CHARS];
+  StringUtils::appendFixed(number, shown, decimals);
+  char buf[48];
+  snprintf(buf, sizeof(buf), "%s%s%s%s", label != NULL ? label : "", label != NULL ? " " : "", number,
+           unit != NULL ? unit : "");
+
+  disp->setFont(font);
+  disp->drawStr(region.x, region.y + region.h - 1 + disp->getDescent(), buf);
+}
+
+PixelView::Bar::Bar(PixelView *px, Region region, BoundValue value, float min, float max)
+    : BoundWidget(px, region), value(value), min(min), max(max) {}
+
+bool PixelView::Bar::sample() {
+  float v = std::min(max, std::max(min, value.get()));
+  int inner = region.w - 4;
+  int width = (max > min) ? (int)((v - min) * inner / (max - min)) : 0;
+  if (width == filled) return false;
+  filled = width;
+  return true;
+}
+
+void PixelView::Bar::draw(U8G2 *disp) {
+  disp->drawFrame(region.x, region.y, region.w, region.h);
+  if (filled > 0) disp->drawBox(region.x + 2, region.y + 2, filled, region.h - 4);
+}
+
+PixelView::Sparkline::Sparkline(PixelView *px, Region region, BoundValue value, unsigned long periodMS, float min,
+                                float max)
+    : BoundWidget(px, region), value(value), periodMS(periodMS), min(min), max(max), samples(region.w) {}
+
+bool PixelView::Sparkline::sample() {
+  unsigned long now = millis();
+  if (!samples.empty() && now - lastSampleMS < periodMS) return false;
+  lastSampleMS = now;
+
+  samples.push(value.get());
+  return true;
+}
+
+void PixelView::Sparkline::draw(U8G2 *disp) {
+  if (samples.empty()) return;
+
+  float lo = min;
+  float hi = max;
+  if (lo == hi) {
+    lo = hi = samples.newest();
+    for (size_t i = 0; i < samples.size(); i++) {
+      lo = std::min(lo, samples[i]);
+      hi = std::max(hi, samples[i]);
     }
-    int centerX = (px->u8g2->getDisplayWidth() - (px->u8g2->getUTF8Width(str.c_str()))) / 2;
-    px->u8g2->drawUTF8(centerX, 64, str.c_str());
-    break;
   }
-  case IndicatorType::NUM: {
-    px->u8g2->setFont(u8g2_font_6x12_tr);
-    // Count enabled pages
-    size_t enabledCount = 0;
-    size_t currentEnabledIndex = 0;
-    for (size_t i = 0; i < numPages; i++) {
-      if (pages[i].enabled) {
-        enabledCount++;
-        if (i <= index) currentEnabledIndex = enabledCount;
-      }
-    }
-    char buf[64];
-    sprintf(buf, "%zu of %zu", currentEnabledIndex, enabledCount);
-    int centerX = (px->u8g2->getDisplayWidth() - (px->u8g2->getUTF8Width(buf))) / 2;
-    px->u8g2->drawStr(centerX, 64, buf);
-    break;
+  float span = (hi > lo) ? hi - lo : 1;
+
+  // Newest sample on the right edge
+  int x = region.x + region.w - samples.size();
+  int prevY = -1;
+  for (size_t i = 0; i < samples.size(); i++, x++) {
+    float v = std::min(hi, std::max(lo, samples[i]));
+    int y = region.y + region.h - 1 - (int)((v - lo) * (region.h - 1) / span);
+    if (prevY < 0) disp->drawPixel(x, y);
+    else disp->drawLine(x - 1, prevY, x, y);
+    prevY = y;
   }
-  case IndicatorType::NUM_ARROW: {
-    px->u8g2->setFont(u8g2_font_6x12_tr);
-    // Count enabled pages similar to NUM case
-    size_t enabledCount = 0;
-    size_t currentEnabledIndex = 0;
-    for (size_t i = 0; i < numPages; i++) {
-      if (pages[i].enabled) {
-        enabledCount++;
-        if (i <= index) currentEnabledIndex = enabledCount;
-      }
-    }
-    char buf[64];
-    sprintf(buf, "< %zu of %zu >", currentEnabledIndex, enabledCount);
-    int centerX = (px->u8g2->getDisplayWidth() - (px->u8g2->getUTF8Width(buf))) / 2;
-    px->u8g2->drawStr(centerX, 64, buf);
-    break;
+}
+
+static size_t chartBucketSize(size_t capacity, int16_t columns) {
+  if (columns <= 0) columns = 1;
+  size_t size = (capacity + columns - 1) / columns;
+  return size > 0 ? size : 1;
+}
+
+PixelView::Chart::Chart(PixelView *px, Region region, size_t capacity, float min, float max)
+    : BoundWidget(px, region), bucketSize(chartBucketSize(capacity, region.w)),
+      samples(bucketSize * (region.w > 0 ? region.w : 1) + 1), min(min), max(max), lo(min), hi(max) {}
+
+void PixelView::Chart::push(float value) {
+  bool newBucket = (total % bucketSize) == 0;
+  samples.push(value);
+  total++;
+
+  if (newBucket) newColumns++;
+  if (min == max && (value < lo || value > hi || samples.size() == 1)) fullRedraw = true;
+  dirty = true;
+}
+
+bool PixelView::Chart::bucketRange(unsigned long bucket, float *bLo, float *bHi) {
+  unsigned long oldest = total - samples.size();
+  unsigned long first = bucket * bucketSize;
+  unsigned long last = first + bucketSize; // Exclusive
+  if (last <= oldest || first >= total) return false;
+
+  // Start one sample early so consecutive columns join up
+  unsigned long from = std::max(oldest, first == 0 ? 0 : first - 1);
+  unsigned long to = std::min(last, total);
+
+  *bLo = *bHi = samples[from - oldest];
+  for (unsigned long i = from + 1; i < to; i++) {
+    float v = samples[i - oldest];
+    *bLo = std::min(*bLo, v);
+    *bHi = std::max(*bHi, v);
   }
-  case IndicatorType::ARROW: {
-    px->u8g2->setFont(u8g2_font_6x12_tr);
-    const char *buf = "<      >";
-    int centerX = (px->u8g2->getDisplayWidth() - (px->u8g2->getUTF8Width(buf))) / 2;
-    px->u8g2->drawStr(centerX, 64, buf);
-    break;
+  return true;
+}
+
+int PixelView::Chart::toY(float v) const {
+  float span = (hi > lo) ? hi - lo : 1;
+  v = std::min(hi, std::max(lo, v));
+  return region.y + region.h - 1 - (int)((v - lo) * (region.h - 1) / span);
+}
+
+void PixelView::Chart::drawBucket(U8G2 *disp, unsigned long bucket) {
+  unsigned long newestBucket = (total - 1) / bucketSize;
+  if (newestBucket - bucket >= (unsigned long)region.w) return; // Scrolled off the left edge
+
+  float bLo, bHi;
+  if (!bucketRange(bucket, &bLo, &bHi)) return;
+
+  int x = region.x + region.w - 1 - (int)(newestBucket - bucket);
+  int yTop = toY(bHi);
+  disp->drawVLine(x, yTop, toY(bLo) - yTop + 1);
+}
+
+void PixelView::Chart::draw(U8G2 *disp) {
+  if (samples.empty()) return;
+
+  if (min == max) {
+    lo = hi = samples.newest();
+    for (size_t i = 0; i < samples.size(); i++) {
+      lo = std::min(lo, samples[i]);
+      hi = std::max(hi, samples[i]);
+    }
   }
-  case IndicatorType::NONE:
-    break;
+
+  unsigned long oldestBucket = (total - samples.size()) / bucketSize;
+  unsigned long newestBucket = (total - 1) / bucketSize;
+  for (unsigned long b = oldestBucket; b <= newestBucket; b++)
+    drawBucket(disp, b);
+}
+
+void PixelView::Chart::redraw() {
+  if (fullRedraw || newColumns >= (size_t)region.w || !px->shiftRegionLeft(region, newColumns)) {
+    BoundWidget::redraw();
+  } else if (!samples.empty()) {
+    // The previous rightmost column may have been a partial bucket, so it is redrawn with the new ones
+    unsigned long newestBucket = (total - 1) / bucketSize;
+    int firstX = region.x + region.w - 1 - (int)newColumns;
+    px->clearRegion({(int16_t)firstX, region.y, (int16_t)(newColumns + 1), region.h});
+    for (unsigned long b = newestBucket - std::min<unsigned long>(newColumns, newestBucket); b <= newestBucket; b++)
+      drawBucket(px->u8g2, b);
   }
 
-  px->u8g2->sendBuffer();
-  ActionType input = px->doInput();
+  fullRedraw = false;
+  newColumns = 0;
+}
 
-  if ((input == ActionType::LEFT) || (input == ActionType::UP)) {
-    // Find previous enabled page
-    do {
-      index = (index == 0) ? numPages - 1 : index - 1;
-    } while (!pages[index].enabled && index != originalIndex);
+PixelView::StatusIcon::StatusIcon(PixelView *px, Region region, BoundValue value, const unsigned char *icons[],
+                                  const size_t numIcons)
+    : BoundWidget(px, region), value(value), icons(icons), numIcons(numIcons) {}
+
+bool PixelView::StatusIcon::sample() {
+  if (numIcons == 0) return false; // Nothing to show
+  int s = (int)value.get();
+  if (s < 0) s = 0;
+  if (s >= (int)numIcons) s = numIcons - 1;
+  if (s == state) return false;
+  state = s;
+  return true;
+}
+
+void PixelView::StatusIcon::draw(U8G2 *disp) {
+  if (state < 0) return; // Not sampled yet, or no icons
+  disp->setBitmapMode(1);
+  px->drawIcon(region.x, region.y, region.w, region.h, icons[state]);
+}
+
+static bool regionsIntersect(const PixelView::Region &a, const PixelView::Region &b) {
+  return a.x < b.x + b.w && b.x < a.x + a.w && a.y < b.y + b.h && b.y < a.y + a.h;
+}
+
+void PixelView::Node::layout(U8G2 * /*disp*/, const Region &bounds) {
+  this->bounds = bounds;
+  invalidate();
+}
+
+void PixelView::Node::invalidate() {
+  dirty = true;
+  // Ancestors of a node with subtreeDirty set already have it set
+  for (Node *n = this; n != NULL && !n->subtreeDirty; n = n->parent)
+    n->subtreeDirty = true;
+}
+
+PixelView::Container::Container(Node *children[], const size_t numChildren, Direction direction, int16_t gap)
+    : children(children), numChildren(numChildren), direction(direction), gap(gap) {
+  for (size_t i = 0; i < numChildren; i++)
+    adopt(children[i]);
+}
 
-    while (px->doInput() != ActionType::NONE)
-      this->px->doDelay(100);
+PixelView::Node::Size PixelView::Container::measure(U8G2 *disp, Size available) {
+  bool vertical = direction == Direction::VERTICAL;
+  int16_t remaining = vertical ? available.h : available.w;
+  int16_t along = 0, across = 0;
+  for (size_t i = 0; i < numChildren && remaining > 0; i++) {
+    Size size = children[i]->measure(disp, vertical ? Size{available.w, remaining} : Size{remaining, available.h});
+    int16_t length = std::min(vertical ? size.h : size.w, remaining);
+    along += length + (i + 1 < numChildren ? gap : 0);
+    across = std::max(across, vertical ? size.w : size.h);
+    remaining -= length + gap;
   }
+  along = std::min(along, vertical ? available.h : available.w);
+  return vertical ? Size{across, along} : Size{along, across};
+}
 
-  if ((input == ActionType::RIGHT) || (input == ActionType::DOWN)) {
-    // Find next enabled page
-    do {
-      index = (index + 1) % numPages;
-    } while (!pages[index].enabled && index != originalIndex);
+void PixelView::Container::layout(U8G2 *disp, const Region &bounds) {
+  Node::layout(disp, bounds);
+
+  bool vertical = direction == Direction::VERTICAL;
+  int16_t pos = vertical ? bounds.y : bounds.x;
+  int16_t end = vertical ? bounds.y + bounds.h : bounds.x + bounds.w;
+  for (size_t i = 0; i < numChildren; i++) {
+    int16_t remaining = std::max(0, end - pos);
+    Size size = children[i]->measure(disp, vertical ? Size{bounds.w, remaining} : Size{remaining, bounds.h});
+    int16_t length = i + 1 == numChildren ? remaining : std::min(vertical ? size.h : size.w, remaining);
+    Region slot = vertical ? Region{bounds.x, pos, bounds.w, length} : Region{pos, bounds.y, length, bounds.h};
+    children[i]->layout(disp, slot);
+    pos += length + gap;
+  }
+}
+
+PixelView::Label::Label(const char *text, const uint8_t *font, Align align, bool inverted)
+    : font(font), align(align), inverted(inverted) {
+  this->text[0] = '\0';
+  setText(text);
+}
+
+void PixelView::Label::setText(const char *text) {
+  if (text == NULL) text = "";
+  if (strncmp(this->text, text, sizeof(this->text) - 1) == 0) return;
+  strncpy(this->text, text, sizeof(this->text) - 1);
+  this->text[sizeof(this->text) - 1] = '\0';
+  invalidate();
+}
+
+PixelView::Node::Size PixelView::Label::measure(U8G2 *disp, Size available) {
+  if (font != NULL) disp->setFont(font);
+  // Full width in a column; in a row, the width of the text at layout time
+  int16_t w = std::min<int16_t>(available.w, disp->getUTF8Width(text) + 4);
+  int16_t h = std::min<int16_t>(available.h, disp->getMaxCharHeight() + 2);
+  return {w, h};
+}
+
+void PixelView::Label::draw(U8G2 *disp) {
+  if (font != NULL) disp->setFont(font);
+  disp->setFontMode(1);
 
-    while (px->doInput() != ActionType::NONE)
-      this->px->doDelay(100);
+  int16_t textWidth = disp->getUTF8Width(text);
+  int16_t x = bounds.x + 2;
+  if (align == Align::CENTER) x = bounds.x + (bounds.w - textWidth) / 2;
+  if (align == Align::RIGHT) x = bounds.x + bounds.w - textWidth - 2;
+  int16_t y = bounds.y + (bounds.h + disp->getAscent() + disp->getDescent()) / 2;
+
+  if (inverted) {
+    disp->drawBox(bounds.x, bounds.y, bounds.w, bounds.h);
+    disp->setDrawColor(0);
   }
+  disp->drawUTF8(x, y, text);
+  disp->setDrawColor(1);
+  disp->setFontMode(0);
+}
 
-  return returnVal;
+PixelView::Scene::Scene(PixelView *px, Node *root) : px(px), root(root) {}
+
+void PixelView::Scene::layout() {
+  px->u8g2->setFont(px->fonts.mono);
+  root->layout(px->u8g2, {0, 0, Geometry::WIDTH, Geometry::HEIGHT});
+  laidOut = true;
 }
-void PixelView::Pager::loop(int delay) {
-  while (true) {
-    if (render() == PagerActionType::EXIT) {
-      break;
+
+bool PixelView::Scene::render(bool flush) {
+  if (!laidOut) layout();
+
+  sampleTree(root);
+  if (!root->subtreeDirty) return false;
+
+  Region area = {0, 0, 0, 0};
+  bool any = false;
+  collect(root, area, any);
+
+  // Whole tiles are sent (and cleared, with a page buffer), so everything they cover is part of the area
+  int16_t x0 = std::max<int16_t>(0, area.x) & ~7;
+  int16_t y0 = std::max<int16_t>(0, area.y) & ~7;
+  int16_t x1 = std::min<int16_t>(Geometry::WIDTH, (area.x + area.w + 7) & ~7);
+  int16_t y1 = std::min<int16_t>(Geometry::HEIGHT, (area.y + area.h + 7) & ~7);
+  area = {x0, y0, (int16_t)(x1 - x0), (int16_t)(y1 - y0)};
+
+  // A page buffer starts every page blank, so every node in the area is drawn again; a full buffer still holds the
+  // clean ones
+  bool repaint = px->isPageBuffered();
+  px->drawRegion(
+      area,
+      [&] {
+        lastDrawn = 0;
+        paint(root, area, repaint);
+      },
+      flush);
+
+  clean(root);
+  lastRegion = area;
+  return true;
+}
+
+void PixelView::Scene::sampleTree(Node *node) {
+  if (node->sample()) node->invalidate();
+  for (size_t i = 0; i < node->childCount(); i++)
+    sampleTree(node->child(i));
+}
+
+void PixelView::Scene::collect(Node *node, Region &area, bool &any) {
+  if (node->dirty) {
+    // Its children are redrawn with it
+    const Region &b = node->bounds;
+    if (!any) {
+      area = b;
+      any = true;
+      return;
     }
+    int16_t x1 = std::max(area.x + area.w, b.x + b.w);
+    int16_t y1 = std::max(area.y + area.h, b.y + b.h);
+    area.x = std::min(area.x, b.x);
+    area.y = std::min(area.y, b.y);
+    area.w = x1 - area.x;
+    area.h = y1 - area.y;
+    return;
+  }
+  if (!node->subtreeDirty) return;
+  for (size_t i = 0; i < node->childCount(); i++)
+    collect(node->child(i), area, any);
+}
 
-    this->px->doDelay(delay);
+void PixelView::Scene::paint(Node *node, const Region &area, bool repaint) {
+  if (!regionsIntersect(node->bounds, area)) return;
+
+  if (repaint || node->dirty) {
+    drawNode(node);
+    repaint = true;
+  } else if (!node->subtreeDirty) {
+    return;
   }
+  for (size_t i = 0; i < node->childCount(); i++)
+    paint(node->child(i), area, repaint);
+}
+
+void PixelView::Scene::drawNode(Node *node) {
+  const Region &b = node->bounds;
+  px->u8g2->setClipWindow(b.x, b.y, b.x + b.w, b.y + b.h);
+  px->clearRegion(b);
+  px->u8g2->setFont(px->fonts.mono);
+  node->draw(px->u8g2);
+  px->u8g2->setMaxClipWindow();
+  px->u8g2->setDrawColor(1);
+  lastDrawn++;
 }
 
-static const unsigned char bitmap_sel_outline[] U8X8_PROGMEM = {
-    0xf8, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x03, 0x04, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x0c, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x0c, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x02, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x02, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x0c, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x0c, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x02,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x02, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    0x00, 0x00, 0x0c, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c,
-    0xfc, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x07, 0xf8, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x03};
-
-static const unsigned char bitmap_scrollbar_background_full[] U8X8_PROGMEM = {
-    0x00, 0x40, 0x00, 0x40, 0x00, 0x40, 0x00, 0x40, 0x00, 0x40, 0x00, 0x40, 0x00, 0x40, 0x00, 0x40,
-    0x00, 0x40, 0x00, 0x40, 0x00, 0x40, 0x00, 0x40, 0x00, 0x40, 0x00, 0x40, 0x00, 0x40, 0x00, 0x40,
-    0x00, 0x40, 0x00, 0x40, 0x00, 0x40, 0x00, 0x40, 0x00, 0x40, 0x00, 0x40, 0x00, 0x40, 0x00, 0x40,
-    0x00, 0x40, 0x00, 0x40, 0x00, 0x40, 0x00, 0x40, 0x00, 0x40, 0x00, 0x40, 0x00, 0x40, 0x00, 0x00};
+void PixelView::Scene::clean(Node *node) {
+  if (!node->dirty && !node->subtreeDirty) return;
+  node->dirty = false;
+  node->subtreeDirty = false;
+  for (size_t i = 0; i < node->childCount(); i++)
+    clean(node->child(i));
+}
+
+// Converted from XBM with tools/xbm2tiles.py
+// bitmap_sel_outline: 128x21, 384 bytes
+static const unsigned char bitmap_sel_outline_tiles[] U8X8_PROGMEM = {
+    0x00, 0xfc, 0x02, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0xfe, 0xfc, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x07, 0x08, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18,
+    0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18,
+    0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18,
+    0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18,
+    0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18,
+    0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18,
+    0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18,
+    0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x0f, 0x07, 0x00, 0x00, 0x00, 0x00,
+};
+static const TileBitmap bitmap_sel_outline = {128, 21, bitmap_sel_outline_tiles};
+
+// The scrollbar track, one 8x8 tile repeated down the right edge: a dot on every other row, none on the last
+static const unsigned char bitmap_scrollbar_track_tiles[] U8X8_PROGMEM = {0, 0, 0, 0, 0, 0, 0xaa, 0};
+static const TileBitmap bitmap_scrollbar_track = {8, 8, bitmap_scrollbar_track_tiles};
+static const unsigned char bitmap_scrollbar_end_tiles[] U8X8_PROGMEM = {0, 0, 0, 0, 0, 0, 0x2a, 0};
+static const TileBitmap bitmap_scrollbar_end = {8, 8, bitmap_scrollbar_end_tiles};
+
+void PixelView::drawScrollbar(int handleY, int handleHeight) {
+  for (int y = 0; y < Geometry::HEIGHT - 8; y += 8)
+    drawTileBitmap(Geometry::SCROLLBAR_X, y, bitmap_scrollbar_track);
+  drawTileBitmap(Geometry::SCROLLBAR_X, Geometry::HEIGHT - 8, bitmap_scrollbar_end);
+  u8g2->drawRBox(Geometry::SCROLLBAR_HANDLE_X, handleY, 3, handleHeight, 1);
+}
+
+void PixelView::drawSelectionOutline(int y) {
+  if (Geometry::WIDTH == 128) {
+    drawTileBitmap(0, y, bitmap_sel_outline);
+    return;
+  }
+
+  // Same shape as bitmap_sel_outline, stretched: a rounded frame with a 1 pixel shadow on the right
+  const int right = Geometry::MENU_OUTLINE_RIGHT;
+  u8g2->drawHLine(3, y, right - 3);
+  u8g2->drawPixel(2, y + 1);
+  u8g2->drawPixel(right, y + 1);
+  u8g2->drawVLine(1, y + 2, 17);
+  u8g2->drawBox(right, y + 2, 2, 17);
+  u8g2->drawHLine(2, y + 19, right - 1);
+  u8g2->drawHLine(3, y + 20, right - 3);
+}
 
 int PixelView::menu(menuItem items[], const size_t numItems, int index) {
   int itemSelected = index;
-  int prevItem;
-  int nextItem;
 
   while (true) {
     ActionType input = doInput();
@@ -777,48 +1924,54 @@ int PixelView::menu(menuItem items[], const size_t numItems, int index) {
       return itemSelected;
     }
 
-    prevItem = itemSelected - 1;
-    if (prevItem < 0) prevItem = numItems - 1;
-
-    nextItem = itemSelected + 1;
-    if (nextItem >= numItems) nextItem = 0;
-
-    u8g2->clearBuffer();
-    u8g2->setBitmapMode(1);
-
-    u8g2->drawXBMP(4, 2, 16, 16, items[prevItem].icon);
-    u8g2->drawXBMP(4, 24, 16, 16, items[itemSelected].icon);
-    u8g2->drawXBMP(4, 46, 16, 16, items[nextItem].icon);
-
-    int maxWidth = 90;
+    drawFrame([&] {
+      drawIconMenu(numItems, itemSelected, [&](int i) { return items[i].name.c_str(); },
+                   [&](int i) { return items[i].icon; });
+    });
+  }
+}
 
-    u8g2->setFont(u8g2_font_helvR08_tr);
+int PixelView::menuLevel(const MenuNode &node, int index) {
+  const MenuNode *entries = node.children;
+  const int numItems = node.numChildren;
+  int itemSelected = index;
 
-    u8g2->drawStr(24, 15, items[prevItem].name.c_str());
+  bool icons = false;
+  for (int i = 0; i < numItems; i++) icons |= entries[i].icon != NULL;
 
-    u8g2->drawXBMP(0, 22, 128, 21, bitmap_sel_outline);
+  while (true) {
+    ActionType input = doInput();
 
-    // Draw selected item with a bold font
-    u8g2->setFont(u8g2_font_helvB08_tr);
-    u8g2->drawStr(25, 37, items[itemSelected].name.c_str());
+    if (input == ActionType::UP) {
+      itemSelected--;
+      if (itemSelected < 0) itemSelected = numItems - 1;
+    } else if (input == ActionType::DOWN) {
+      itemSelected++;
+      if (itemSelected >= numItems) itemSelected = 0;
+    }
 
-    // Draw next item
-    u8g2->setFont(u8g2_font_helvR08_tr);
+    if (input != ActionType::NONE) {
+      while (doInput() != ActionType::NONE) {
+        doDelay(70);
+      }
+    }
 
-    u8g2->drawStr(25, 59, items[nextItem].name.c_str());
+    if (input == ActionType::SEL) return itemSelected;
+    if (input == ActionType::LEFT) return -1;
 
+    drawFrame([&] {
+      auto nameAt = [&](int i) { return entries[i].label; };
+      if (icons) drawIconMenu(numItems, itemSelected, nameAt, [&](int i) { return entries[i].icon; });
+      else drawScrollList(node.label, numItems, itemSelected, 1, nameAt);
+    });
     u8g2->setDrawColor(1);
-    u8g2->drawXBMP(120, 0, 8, 64, bitmap_scrollbar_background_full);
-    u8g2->drawRBox(125, 64 / numItems * itemSelected, 3, 64 / numItems, 1);
 
-    u8g2->sendBuffer();
+    doDelay(50);
   }
 }
 
 int PixelView::subMenu(const char *header, const char *items[], const size_t numItems, int index) {
   int itemSelected = index;
-  int prevItem;
-  int nextItem;
 
   while (true) {
 
@@ -848,37 +2001,7 @@ int PixelView::subMenu(const char *header, const char *items[], const size_t num
       }
       return itemSelected;
     }
-    prevItem = itemSelected - 1;
-    if (prevItem < 0) prevItem = numItems - 1;
-
-    nextItem = itemSelected + 1;
-    if (nextItem >= numItems) nextItem = 0;
-
-    u8g2->clearBuffer();
-    // u8g2->setBitmapMode(1);
-    u8g2->setDrawColor(1);
-
-    u8g2->drawXBMP(120, 0, 8, 64, bitmap_scrollbar_background_full);
-
-    int scrollbarH = std::max(1, (int)(64 / numItems));
-    int scrollbarY;
-
-    // if ((64 / numItems * itemSelected) < 0) scrollbarY = 1;
-    /*else*/ scrollbarY = (64.0 / numItems) * itemSelected;
-
-    u8g2->drawRBox(125, scrollbarY, 3, scrollbarH, 1);
-
-    u8g2->setFont(u8g2_font_helvB08_tr);
-    u8g2->drawStr(1, 11, header);
-
-    u8g2->setFont(u8g2_font_helvR08_tr);
-    u8g2->drawStr(8, 28, items[prevItem]);
-    u8g2->drawStr(8, 44, items[itemSelected]);
-    u8g2->drawStr(8, 60, items[nextItem]);
-
-    u8g2->setDrawColor(2);
-    u8g2->drawRBox(2, 33, 121, 15, 1);
-    u8g2->sendBuffer();
+    drawFrame([&] { drawScrollList(header, numItems, itemSelected, 1, [&](int i) { return items[i]; }); });
     u8g2->setDrawColor(1);
 
     doDelay(50);
@@ -887,8 +2010,6 @@ int PixelView::subMenu(const char *header, const char *items[], const size_t num
 
 int PixelView::subMenu(const char *header, const String items[], const size_t numItems, int index) {
   int itemSelected = index;
-  int prevItem;
-  int nextItem;
 
   while (true) {
 
@@ -918,37 +2039,7 @@ int PixelView::subMenu(const char *header, const String items[], const size_t nu
       }
       return itemSelected;
     }
-    prevItem = itemSelected - 1;
-    if (prevItem < 0) prevItem = numItems - 1;
-
-    nextItem = itemSelected + 1;
-    if (nextItem >= numItems) nextItem = 0;
-
-    u8g2->clearBuffer();
-    // u8g2->setBitmapMode(1);
-    u8g2->setDrawColor(1);
-
-    u8g2->drawXBMP(120, 0, 8, 64, bitmap_scrollbar_background_full);
-
-    int scrollbarH = std::max(2, (int)(64 / numItems));
-    int scrollbarY;
-
-    // if ((64 / numItems * itemSelected) < 0) scrollbarY = 1;
-    /* else */ scrollbarY = (64.0 / numItems) * itemSelected;
-
-    u8g2->drawRBox(125, scrollbarY, 3, scrollbarH, 1);
-
-    u8g2->setFont(u8g2_font_helvB08_tr);
-    u8g2->drawStr(1, 11, header);
-
-    u8g2->setFont(u8g2_font_helvR08_tr);
-    u8g2->drawStr(8, 28, items[prevItem].c_str());
-    u8g2->drawStr(8, 44, items[itemSelected].c_str());
-    u8g2->drawStr(8, 60, items[nextItem].c_str());
-
-    u8g2->setDrawColor(2);
-    u8g2->drawRBox(2, 33, 121, 15, 1);
-    u8g2->sendBuffer();
+    drawFrame([&] { drawScrollList(header, numItems, itemSelected, 2, [&](int i) { return items[i].c_str(); }); });
     u8g2->setDrawColor(1);
 
     doDelay(50);
@@ -990,10 +2081,97 @@ void PixelView::search(const String items[], const size_t numItems, const char *
   }
 }
 
+int PixelView::carousel(const unsigned char *icons[], const size_t numItems, uint8_t iconSize) {
+  if (numItems == 0) return -1;
+
+  // Decoded icons of selected - 2 .. selected + 2: the neighbours shown, and the ones sliding in next
+  const int slots = 5;
+  const size_t bytes = TileBitmap::bytesFor(iconSize, iconSize);
+  uint8_t *tiles = (uint8_t *)malloc(slots * bytes);
+  if (tiles == NULL) return -1;
+  long slotIndex[slots];
+  for (long &index : slotIndex)
+    index = -1;
+
+  const int gap = 8;
+  const int spacing = iconSize + gap;
+  const int left = (Geometry::WIDTH - iconSize) / 2;
+  const int top = (Geometry::HEIGHT - iconSize) / 2;
+  long selected = 0;
+
+  auto wrap = [&](long index) { return ((index % (long)numItems) + (long)numItems) % (long)numItems; };
+  auto inWindow = [&](long index) {
+    for (int k = -2; k <= 2; k++)
+      if (wrap(selected + k) == index) return true;
+    return false;
+  };
+  // The decoded icon, decoding it into a slot no longer in the window if needed
+  auto decoded = [&](long index) -> const uint8_t * {
+    index = wrap(index);
+    int slot = -1;
+    for (int i = 0; i < slots; i++) {
+      if (slotIndex[i] == index) return tiles + i * bytes;
+      if (slot < 0 && (slotIndex[i] < 0 || !inWindow(slotIndex[i]))) slot = i;
+    }
+    if (slot < 0) slot = 0;
+    decodeIcon(iconSize, iconSize, icons[index], tiles + slot * bytes);
+    slotIndex[slot] = index;
+    return tiles + slot * bytes;
+  };
+  // Decodes one icon of the window that isn't ready yet. Returns false if they all are
+  auto prefetch = [&]() {
+    for (int k : {0, 1, -1, 2, -2}) {
+      long index = wrap(selected + k);
+      bool ready = false;
+      for (long cached : slotIndex)
+        ready |= cached == index;
+      if (!ready) {
+        decoded(index);
+        return true;
+      }
+    }
+    return false;
+  };
+  auto render = [&](int shift) {
+    drawFrame([&] {
+      for (int k = -2; k <= 2; k++) {
+        int x = left + k * spacing - shift;
+        if (x >= Geometry::WIDTH || x + iconSize <= 0) continue;
+        blitTiles(x, top, iconSize, iconSize, decoded(selected + k), false);
+      }
+    });
+  };
+
+  render(0);
+  while (true) {
+    ActionType action = doInput();
+    if (action == ActionType::SEL) break;
+    if (action != ActionType::LEFT && action != ActionType::RIGHT) {
+      if (!prefetch()) doDelay(20);
+      continue;
+    }
+
+    // Slide by one icon, fast at first and slowing down at the end
+    int direction = action == ActionType::RIGHT ? 1 : -1;
+    const int steps = 4;
+    for (int step = 1; step < steps; step++) {
+      int remaining = steps - step;
+      render(direction * (spacing - spacing * remaining * remaining / (steps * steps)));
+    }
+    selected = wrap(selected + direction);
+    render(0);
+
+    while (doInput() != ActionType::NONE) {
+      if (!prefetch()) doDelay(20);
+    }
+  }
+
+  free(tiles);
+  return (int)selected;
+}
+
 int PixelView::searchList(const char *header, const char *items[], const size_t numItems, bool caseSensitive) {
   int itemSelected = 0;
-  int prevItem;
-  int nextItem;
 
   String query = "";
 
@@ -1058,39 +2236,11 @@ int PixelView::searchList(const char *header, const char *items[], const size_t
       continue;
     }
 
-    prevItem = itemSelected - 1;
-    if (prevItem < 0) prevItem = resultCount - 1;
-
-    nextItem = itemSelected + 1;
-    if (nextItem >= resultCount) nextItem = 0;
-
-    u8g2->clearBuffer();
-    // u8g2->setBitmapMode(1);
-    u8g2->setDrawColor(1);
-
-    u8g2->drawXBMP(120, 0, 8, 64, bitmap_scrollbar_background_full);
-
-    int scrollbarH = std::max(2, (int)(64 / resultCount));
-    int scrollbarY;
-
-    // if ((64 / numItems * itemSelected) < 0) scrollbarY = 1;
-    /* else */ scrollbarY = (64.0 / resultCount) * itemSelected;
-
-    u8g2->drawRBox(125, scrollbarY, 3, scrollbarH, 1);
-
-    u8g2->setFont(u8g2_font_helvB08_tr);
-    char buf[64];
-    snprintf(buf, 64, "%s (%zu/%zu)", header, resultCount, numItems);
-    u8g2->drawStr(1, 11, buf);
-
-    u8g2->setFont(u8g2_font_helvR08_tr);
-    u8g2->drawStr(8, 28, result[prevItem]);
-    u8g2->drawStr(8, 44, result[itemSelected]);
-    u8g2->drawStr(8, 60, result[nextItem]);
-
-    u8g2->setDrawColor(2);
-    u8g2->drawRBox(2, 33, 121, 15, 1);
-    u8g2->sendBuffer();
+    drawFrame([&] {
+      char buf[64];
+      snprintf(buf, 64, "%s (%zu/%zu)", header, resultCount, numItems);
+      drawScrollList(buf, resultCount, itemSelected, 2, [&](int i) { return result[i]; });
+    });
     u8g2->setDrawColor(1);
 
     doDelay(50);
@@ -1099,8 +2249,6 @@ int PixelView::searchList(const char *header, const char *items[], const size_t
 
 int PixelView::searchList(const char *header, const String items[], const size_t numItems, bool caseSensitive) {
   int itemSelected = 0;
-  int prevItem;
-  int nextItem;
 
   String query = "";
 
@@ -1165,39 +2313,11 @@ int PixelView::searchList(const char *header, const String items[], const size_t
       continue;
     }
 
-    prevItem = itemSelected - 1;
-    if (prevItem < 0) prevItem = resultCount - 1;
-
-    nextItem = itemSelected + 1;
-    if (nextItem >= resultCount) nextItem = 0;
-
-    u8g2->clearBuffer();
-    // u8g2->setBitmapMode(1);
-    u8g2->setDrawColor(1);
-
-    u8g2->drawXBMP(120, 0, 8, 64, bitmap_scrollbar_background_full);
-
-    int scrollbarH = std::max(2, (int)(64 / resultCount));
-    int scrollbarY;
-
-    // if ((64 / numItems * itemSelected) < 0) scrollbarY = 1;
-    /* else */ scrollbarY = (64.0 / resultCount) * itemSelected;
-
-    u8g2->drawRBox(125, scrollbarY, 3, scrollbarH, 1);
-
-    u8g2->setFont(u8g2_font_helvB08_tr);
-    char buf[64];
-    snprintf(buf, 64, "%s (%zu/%zu)", header, resultCount, numItems);
-    u8g2->drawStr(1, 11, buf);
-
-    u8g2->setFont(u8g2_font_helvR08_tr);
-    u8g2->drawStr(8, 28, result[prevItem]);
-    u8g2->drawStr(8, 44, result[itemSelected]);
-    u8g2->drawStr(8, 60, result[nextItem]);
-
-    u8g2->setDrawColor(2);
-    u8g2->drawRBox(2, 33, 121, 15, 1);
-    u8g2->sendBuffer();
+    drawFrame([&] {
+      char buf[64];
+      snprintf(buf, 64, "%s (%zu/%zu)", header, resultCount, numItems);
+      drawScrollList(buf, resultCount, itemSelected, 2, [&](int i) { return result[i]; });
+    });
     u8g2->setDrawColor(1);
 
     doDelay(50);
@@ -1205,34 +2325,95 @@ int PixelView::searchList(const char *header, const String items[], const size_t
 }
 
 int PixelView::gridMenu(const unsigned char *icon[], const size_t numItems) {
-  int selected = 0;
-  int itemsPerRow = 6;                                   // Adjust based on your layout
-  int rows = (numItems + itemsPerRow - 1) / itemsPerRow; // Calculate total rows
-  int itemSize = 16;                                     // Icon size
-  int padding = 4;                                       // Padding between icons
-
-  while (true) {
-    u8g2->clearBuffer();
-
-    for (int i = 0; i < numItems; i++) {
-      int row = i / itemsPerRow;
-      int col = i % itemsPerRow;
+  return iconGrid([icon](size_t i) { return icon[i]; }, numItems, 0, false);
+}
 
-      int x = padding + col * (itemSize + padding);
-      int y = padding + row * (itemSize + padding);
+PixelView::Region PixelView::gridCell(int index, int top) {
+  const int itemSize = 16; // Icon size
+  const int padding = 4;   // Padding between icons
+  int row = index / Geometry::GRID_COLUMNS - top;
+  int col = index % Geometry::GRID_COLUMNS;
+  return {(int16_t)(padding + col * (itemSize + padding) - 2), (int16_t)(padding + row * (itemSize + padding) - 2), 19,
+          19};
+}
 
-      // Draw icon
-      u8g2->drawXBMP(x, y, itemSize, itemSize, icon[i]);
+void PixelView::drawGrid(const std::function<const unsigned char *(size_t)> &iconAt, size_t numItems, int top,
+                         int selected, bool streamed) {
+  // Rows outside the current page (page buffers) or the clip window (cell redraws) are skipped
+  u8g2_t *u = u8g2->getU8g2();
+  if (!u->is_page_clip_window_intersection) return;
+  int visibleTop = std::max<int>(u8g2->getBufferCurrTileRow() * 8, u->user_y0);
+  int visibleBottom = std::min<int>((u8g2->getBufferCurrTileRow() + u8g2->getBufferTileHeight()) * 8, u->user_y1);
+
+  for (int row = top; row < top + Geometry::GRID_ROWS; row++) {
+    for (int col = 0; col < Geometry::GRID_COLUMNS; col++) {
+      size_t i = (size_t)row * Geometry::GRID_COLUMNS + col;
+      if (i >= numItems) break;
+      Region cell = gridCell(i, top);
+      if (cell.y + cell.h <= visibleTop || cell.y >= visibleBottom) break;
+      if (cell.x + cell.w <= u->user_x0 || cell.x >= u->user_x1) continue;
+
+      const unsigned char *icon = iconAt(i);
+      if (icon != NULL) drawCachedIcon(cell.x + 2, cell.y + 2, 16, 16, icon, streamed, i);
 
       // Draw selection box if this item is selected
-      if (i == selected) {
+      if ((int)i == selected) {
         u8g2->setDrawColor(2);
-        u8g2->drawRBox(x - 2, y - 2, 19, 19, 0);
+        u8g2->drawRBox(cell.x, cell.y, cell.w, cell.h, 0);
         u8g2->setDrawColor(1);
       }
     }
+  }
+
+  int rows = (numItems + Geometry::GRID_COLUMNS - 1) / Geometry::GRID_COLUMNS;
+  if (rows > Geometry::GRID_ROWS) {
+    int handleHeight = std::max(4, Geometry::HEIGHT * Geometry::GRID_ROWS / rows);
+    u8g2->drawRBox(Geometry::SCROLLBAR_HANDLE_X, (Geometry::HEIGHT - handleHeight) * top / (rows - Geometry::GRID_ROWS),
+                   3, handleHeight, 1);
+  }
+}
+
+int PixelView::gridMenu(IconSourceType iconAt, const size_t numItems, int selected) {
+  // Indices cached by an earlier gridMenu() may stand for other icons in this one
+  forgetStreamedIcons();
+  return iconGrid(iconAt, numItems, selected, true);
+}
 
-    u8g2->sendBuffer();
+int PixelView::iconGrid(const std::function<const unsigned char *(size_t)> &iconAt, size_t numItems, int selected,
+                        bool streamed) {
+  if (numItems == 0) return -1;
+  const int itemsPerRow = Geometry::GRID_COLUMNS;
+  if (selected < 0 || selected >= (int)numItems) selected = 0;
+  int top = -1; // First row shown, -1 until the first frame
+  int shown = selected;
+
+  while (true) {
+    // Scroll just enough to show the selected row
+    int row = selected / itemsPerRow;
+    int newTop = top < 0 ? std::max(0, row - Geometry::GRID_ROWS + 1) : top;
+    if (row < newTop) newTop = row;
+    if (row >= newTop + Geometry::GRID_ROWS) newTop = row - Geometry::GRID_ROWS + 1;
+
+    if (newTop != top) {
+      top = newTop;
+      drawFrame([&] { drawGrid(iconAt, numItems, top, selected, streamed); });
+    } else if (shown != selected) {
+      // Only the cells losing and gaining the selection box change
+      for (int index : {shown, selected}) {
+        Region cell = gridCell(index, top);
+        drawRegion(cell, [&] {
+          // A page buffer sends whole tiles: redraw every cell crossing the cell's rows of tiles
+          Region clip = isPageBuffered() ? Region{0, (int16_t)(cell.y / 8 * 8), (int16_t)Geometry::WIDTH,
+                                                  (int16_t)((cell.y + cell.h + 7) / 8 * 8 - cell.y / 8 * 8)}
+                                         : cell;
+          clearRegion(clip);
+          u8g2->setClipWindow(clip.x, std::max<int>(clip.y, 0), clip.x + clip.w, clip.y + clip.h);
+          drawGrid(iconAt, numItems, top, selected, streamed);
+          u8g2->setMaxClipWindow();
+        });
+      }
+    }
+    shown = selected;
 
     switch (doInput()) {
     case ActionType::LEFT: {
@@ -1241,7 +2422,7 @@ int PixelView::gridMenu(const unsigned char *icon[], const size_t numItems) {
       }
     } break;
     case ActionType::RIGHT: {
-      if (selected % itemsPerRow < itemsPerRow - 1 && selected < numItems - 1) {
+      if (selected % itemsPerRow < itemsPerRow - 1 && selected < (int)numItems - 1) {
         selected++;
       }
     } break;
@@ -1251,16 +2432,19 @@ int PixelView::gridMenu(const unsigned char *icon[], const size_t numItems) {
       }
     } break;
     case ActionType::DOWN: {
-      if (selected + itemsPerRow < numItems) {
+      if (selected + itemsPerRow < (int)numItems) {
         selected += itemsPerRow;
       }
     } break;
     case ActionType::SEL:
-      return selected; // Or handle selection as needed
+      return selected;
+    case ActionType::NONE:
+      doDelay(20);
+      continue;
     }
-    while (doInput() != ActionType::NONE)
 
-      // Add a small delay to prevent too rapid updates
+    // Wait for the button to be released
+    while (doInput() != ActionType::NONE)
       doDelay(50);
   }
 }
@@ -1268,49 +2452,46 @@ int PixelView::gridMenu(const unsigned char *icon[], const size_t numItems) {
 int PixelView::radioSelect(const char *header, const char *items[], const size_t numItems) {
   int selected = 0;
   int startIndex = 0;
-  const int itemsPerPage = 4;
+  const int itemsPerPage = Geometry::CHECK_ROWS;
 
   while (true) {
-    u8g2->clearBuffer();
+    drawFrame([&] {
+      // Draw header
+      u8g2->setFont(fonts.title);
+      int headerWidth = u8g2->getUTF8Width(header);
+      int headerX = (Geometry::WIDTH - (u8g2->getUTF8Width(header))) / 2;
+      int headerHeight = u8g2->getMaxCharHeight(); // Assuming header takes up one line
 
-    // Draw header
-    u8g2->setFont(u8g2_font_helvB08_tr);
-    int headerWidth = u8g2->getUTF8Width(header);
-    int headerX = (u8g2->getDisplayWidth() - (u8g2->getUTF8Width(header))) / 2;
-    int headerHeight = u8g2->getMaxCharHeight(); // Assuming header takes up one line
+      u8g2->drawStr(headerX + 2, headerHeight,
+                    header); // Draw header at the top
 
-    u8g2->drawStr(headerX + 2, headerHeight,
-                  header); // Draw header at the top
+      u8g2->setDrawColor(2);
+      u8g2->drawRBox(headerX, 1, headerWidth + 4, headerHeight + 1,
+                     0); // Draw background for header
+      u8g2->setDrawColor(1);
 
-    u8g2->setDrawColor(2);
-    u8g2->drawRBox(headerX, 1, headerWidth + 4, headerHeight + 1,
-                   0); // Draw background for header
-    u8g2->setDrawColor(1);
+      // Draw menu items
+      u8g2->setFont(fonts.small);
 
-    // Draw menu items
-    u8g2->setFont(u8g2_font_haxrcorp4089_tr);
+      for (int i = 0; i < itemsPerPage && (startIndex + i) < numItems; i++) {
+        int itemIndex = startIndex + i;
 
-    for (int i = 0; i < itemsPerPage && (startIndex + i) < numItems; i++) {
-      int itemIndex = startIndex + i;
+        // Draw frame for all items
+        u8g2->drawFrame(5, 17 + (i * 11), 9, 9);
 
-      // Draw frame for all items
-      u8g2->drawFrame(5, 17 + (i * 11), 9, 9);
+        // Draw filled box for selected item
+        if (itemIndex == selected) {
+          u8g2->drawBox(7, 19 + (i * 11), 5, 5);
+        }
 
-      // Draw filled box for selected item
-      if (itemIndex == selected) {
-        u8g2->drawBox(7, 19 + (i * 11), 5, 5);
+        u8g2->drawStr(18, 25 + (i * 11), items[itemIndex]);
       }
 
-      u8g2->drawStr(18, 25 + (i * 11), items[itemIndex]);
-    }
-
-    int handleHeight = 64 / numItems;
-    int handlePosition = 64 / numItems * selected;
+      int handleHeight = Geometry::HEIGHT / numItems;
+      int handlePosition = Geometry::HEIGHT / numItems * selected;
 
-    u8g2->drawXBMP(120, 0, 8, 64, bitmap_scrollbar_background_full);
-    u8g2->drawRBox(125, handlePosition, 3, handleHeight, 1);
-
-    u8g2->sendBuffer();
+      drawScrollbar(handlePosition, handleHeight);
+    });
 
     // Wait for input
     ActionType action;
@@ -1361,56 +2542,16 @@ int PixelView::radioSelect(const char *header, const char *items[], const size_t
 void PixelView::checkBoxes(const char *header, checkBox items[], const size_t numItems) {
   int selected = 0;
   int startIndex = 0;
-  const int itemsPerPage = 4;
+  const int itemsPerPage = Geometry::CHECK_ROWS;
 
   while (true) {
-    u8g2->clearBuffer();
-
-    // Draw header
-    u8g2->setFont(u8g2_font_helvB08_tr);
-    int headerWidth = u8g2->getUTF8Width(header);
-    int headerX = (u8g2->getDisplayWidth() - (u8g2->getUTF8Width(header))) / 2;
-    int headerHeight = u8g2->getMaxCharHeight(); // Assuming header takes up one line
-
-    u8g2->drawStr(headerX + 2, headerHeight,
-                  header); // Draw header at the top
-
-    u8g2->setDrawColor(2);
-    u8g2->drawRBox(headerX, 1, headerWidth + 4, headerHeight + 1,
-                   0); // Draw background for header
-    u8g2->setDrawColor(1);
-
-    // Draw menu items
-    u8g2->setFont(u8g2_font_haxrcorp4089_tr);
-
-    for (int i = 0; i < itemsPerPage && (startIndex + i) < numItems; i++) {
-      int itemIndex = startIndex + i;
-
-      // // Draw frame for all items
-      u8g2->drawFrame(5, 17 + (i * 11), 9, 9);
-
-      // Draw filled box for selected item
-
-      if (items[itemIndex].isChecked) {
-        u8g2->drawBox(7, 19 + (i * 11), 5, 5);
-      }
-
-      if (itemIndex == selected) {
-        u8g2->setDrawColor(2);
-        u8g2->drawBox(8, 20 + (i * 11), 3, 3);
-        u8g2->setDrawColor(1);
-      }
-
-      u8g2->drawStr(18, 25 + (i * 11), items[itemIndex].name);
-    }
-
-    int handleHeight = 64 / numItems;
-    int handlePosition = 64 / numItems * selected;
-
-    u8g2->drawXBMP(120, 0, 8, 64, bitmap_scrollbar_background_full);
-    u8g2->drawRBox(125, handlePosition, 3, handleHeight, 1);
-
-    u8g2->sendBuffer();
+    drawFrame([&] {
+      int handleHeight = Geometry::HEIGHT / numItems;
+      int handlePosition = Geometry::HEIGHT / numItems * selected;
+      drawCheckList(
+          header, NULL, numItems, startIndex, selected, handlePosition, handleHeight,
+          [&](int i) { return items[i].isChecked; }, [&](int i) { return items[i].name; }, [](int) { return false; });
+    });
 
     // Wait for input
     ActionType action;
@@ -1470,13 +2611,116 @@ void PixelView::checkBoxes(const char *header, checkBox items[], const size_t nu
   }
 }
 
+void PixelView::checkBoxes(const char *header, BitSet &checked, LabelSourceType labelAt) {
+  if (!checked.valid()) return;
+  const int numItems = checked.size();
+  if (numItems == 0) return;
+  const int itemsPerPage = Geometry::CHECK_ROWS;
+  int selected = 0;
+  int startIndex = 0;
+  int mark = -1; // Start of the range for the bulk actions
+
+  while (true) {
+    if (selected < startIndex) startIndex = selected;
+    if (selected >= startIndex + itemsPerPage) startIndex = selected - itemsPerPage + 1;
+
+    char status[24];
+    snprintf(status, sizeof(status), "%u/%u", (unsigned)checked.count(), (unsigned)numItems);
+    drawFrame([&] {
+      // One pixel per item is too small to see on long lists
+      int handleHeight = std::max(3, Geometry::HEIGHT / numItems);
+      int handlePosition = (long)(Geometry::HEIGHT - handleHeight) * selected / std::max(1, numItems - 1);
+      drawCheckList(
+          header, status, numItems, startIndex, selected, handlePosition, handleHeight,
+          [&](int i) { return checked.test(i); }, [&](int i) { return labelAt(i); }, [&](int i) { return i == mark; });
+    });
+
+    ActionType action;
+    do {
+      action = doInput();
+    } while (action == ActionType::NONE);
+
+    switch (action) {
+    case ActionType::UP:
+      if (selected > 0) selected--;
+      break;
+
+    case ActionType::DOWN:
+      if (selected < numItems - 1) selected++;
+      break;
+
+    case ActionType::RIGHT:
+      selected = selected + itemsPerPage < numItems ? selected + itemsPerPage : 0;
+      startIndex = selected;
+      break;
+
+    case ActionType::LEFT: {
+      while (doInput() != ActionType::NONE)
+        doDelay(20);
+
+      enum { ALL, NONE, INVERT, MARK, CHECK_RANGE, UNCHECK_RANGE, FIRST, LAST, BACK };
+      const char *actions[] = {"Check all", "Check none", "Invert",   "Mark range start", "Check range",
+                               "Uncheck range", "Go to first", "Go to last", "Back"};
+      int first = std::min(mark, selected), last = std::max(mark, selected);
+      int choice = subMenu(header, actions, sizeof(actions) / sizeof(actions[0]), mark < 0 ? MARK : CHECK_RANGE);
+      switch (choice) {
+      case ALL:
+        checked.setAll(true);
+        break;
+      case NONE:
+        checked.setAll(false);
+        break;
+      case INVERT:
+        checked.flipAll();
+        break;
+      case MARK:
+        mark = selected;
+        break;
+      case CHECK_RANGE:
+      case UNCHECK_RANGE:
+        // Without a mark the range is just the current item
+        if (mark < 0) first = last = selected;
+        checked.setRange(first, last + 1, choice == CHECK_RANGE);
+        mark = -1;
+        break;
+      case FIRST:
+        selected = 0;
+        break;
+      case LAST:
+        selected = numItems - 1;
+        break;
+      }
+    } break;
+
+    case ActionType::SEL: {
+      unsigned long startTime = millis();
+
+      while (doInput() == ActionType::SEL)
+        doDelay(20);
+
+      if ((millis() - startTime) > 1700) { // Long press
+        return;
+      } else {
+        checked.flip(selected);
+      }
+    } break;
+
+    case ActionType::NONE:
+      break;
+    }
+
+    while (doInput() != ActionType::NONE)
+      doDelay(20);
+  }
+}
+
 void PixelView::listBrowser(const char *header, const unsigned char iconBitmap[], const String items[],
                             const size_t numItems, ListType displayType) {
 
   unsigned int offset = 0; // Offset for scrolling
-  int displayHeight = u8g2->getDisplayHeight();
+  int displayHeight = Geometry::HEIGHT;
 
-  u8g2->setFont(u8g2_font_helvB08_tr);
+  u8g2->setFont(fonts.title);
   int fontHeight = u8g2->getMaxCharHeight();
 
   // Reserve space for the header and recalculate visible items
@@ -1491,66 +2735,64 @@ void PixelView::listBrowser(const char *header, const unsigned char iconBitmap[]
   }
 
   do {
-    u8g2->clearBuffer(); // Clear the screen buffer
-    u8g2->setFont(u8g2_font_helvB08_tr);
-
-    // Draw the header at the top
-    int headerWidth = u8g2->getUTF8Width(header);
+    drawFrame([&] {
+      u8g2->setFont(fonts.title);
 
-    int headerX;
-    if (iconBitmap != NULL) headerX = (u8g2->getDisplayWidth() - (u8g2->getUTF8Width(header))) / 2;
-    else headerX = ((u8g2->getDisplayWidth() - (u8g2->getUTF8Width(header))) / 2) - 6;
+      // Draw the header at the top
+      int headerWidth = u8g2->getUTF8Width(header);
 
-    u8g2->drawStr(headerX + 2, headerHeight,
-                  header); // Draw header at the top
+      int headerX;
+      if (iconBitmap != NULL) headerX = (Geometry::WIDTH - (u8g2->getUTF8Width(header))) / 2;
+      else headerX = ((Geometry::WIDTH - (u8g2->getUTF8Width(header))) / 2) - 6;
 
-    u8g2->setDrawColor(2);
-    u8g2->drawRBox(headerX, 1, headerWidth + 4, headerHeight + 1,
-                   0); // Draw background for header
-    u8g2->setDrawColor(1);
-    if (iconBitmap != NULL) u8g2->drawXBMP(headerX - 16 - 2, 0, 16, 16, iconBitmap);
+      u8g2->drawStr(headerX + 2, headerHeight,
+                    header); // Draw header at the top
 
-    u8g2->setFont(font);
+      u8g2->setDrawColor(2);
+      u8g2->drawRBox(headerX, 1, headerWidth + 4, headerHeight + 1,
+                     0); // Draw background for header
+      u8g2->setDrawColor(1);
+      if (iconBitmap != NULL) drawIcon(headerX - 16 - 2, 0, 16, 16, iconBitmap);
 
-    // Scroll handle height and position calculation
-    int handleHeight = (64 * visibleItems) / numItems;
-    int handlePosition = ((64 * offset) / numItems);
+      u8g2->setFont(fonts.mono);
 
-    // Draw scrollbar
+      // Scroll handle height and position calculation
+      int handleHeight = (Geometry::HEIGHT * visibleItems) / numItems;
+      int handlePosition = ((Geometry::HEIGHT * offset) / numItems);
 
-    // u8g2->drawRBox(123, 17, 3, 4, 1);
-    u8g2->drawXBMP(120, 0, 8, 64, bitmap_scrollbar_background_full);
-    u8g2->drawRBox(125, handlePosition, 3, handleHeight, 1);
+      // Draw scrollbar
 
-    // Display list items below the header
-    for (int i = 0; i < visibleItems; i++) {
-      int itemIndex = i + offset; // Adjust for scrolling
+      // u8g2->drawRBox(123, 17, 3, 4, 1);
+      drawScrollbar(handlePosition, handleHeight);
 
-      if (itemIndex >= numItems) {
-        break; // Prevent out-of-bound access when at the last item
-      }
+      // Display list items below the header
+      for (int i = 0; i < visibleItems; i++) {
+        int itemIndex = i + offset; // Adjust for scrolling
 
-      char buf[128];
-      switch (displayType) {
-      case ListType::NONE: {
-        strcpy(buf, items[itemIndex].c_str());
-        break;
-      }
-      case ListType::BULLET: {
-        sprintf(buf, "-° %s", items[itemIndex].c_str());
-        break;
-      }
-      case ListType::NUMBER: {
-        sprintf(buf, "%d. %s", itemIndex + 1, items[itemIndex].c_str());
-      }
-      }
+        if (itemIndex >= numItems) {
+          break; // Prevent out-of-bound access when at the last item
+        }
 
-      // Render list items below the header (start from headerHeight)
-      u8g2->drawStr(5, headerHeight + (i + 1) * u8g2->getMaxCharHeight(),
-                    buf); // Display each item
-    }
+        char buf[128];
+        switch (displayType) {
+        case ListType::NONE: {
+          strcpy(buf, items[itemIndex].c_str());
+          break;
+        }
+        case ListType::BULLET: {
+          sprintf(buf, "-° %s", items[itemIndex].c_str());
+          break;
+        }
+        case ListType::NUMBER: {
+          sprintf(buf, "%d. %s", itemIndex + 1, items[itemIndex].c_str());
+        }
+        }
 
-    u8g2->sendBuffer(); // Send buffer to the display
+        // Render list items below the header (start from headerHeight)
+        u8g2->drawStr(5, headerHeight + (i + 1) * u8g2->getMaxCharHeight(),
+                      buf); // Display each item
+      }
+    });
 
     // Handle input actions
     ActionType action = doInput();
@@ -1581,9 +2823,9 @@ void PixelView::listBrowser(const char *header, const unsigned char iconBitmap[]
                             const size_t numItems, ListType displayType) {
 
   unsigned int offset = 0; // Offset for scrolling
-  int displayHeight = u8g2->getDisplayHeight();
+  int displayHeight = Geometry::HEIGHT;
 
-  u8g2->setFont(u8g2_font_helvB08_tr);
+  u8g2->setFont(fonts.title);
   int fontHeight = u8g2->getMaxCharHeight();
 
   // Reserve space for the header and recalculate visible items
@@ -1598,66 +2840,64 @@ void PixelView::listBrowser(const char *header, const unsigned char iconBitmap[]
   }
 
   do {
-    u8g2->clearBuffer(); // Clear the screen buffer
-    u8g2->setFont(u8g2_font_helvB08_tr);
-
-    // Draw the header at the top
-    int headerWidth = u8g2->getUTF8Width(header);
+    drawFrame([&] {
+      u8g2->setFont(fonts.title);
 
-    int headerX;
-    if (iconBitmap != NULL) headerX = (u8g2->getDisplayWidth() - (u8g2->getUTF8Width(header))) / 2;
-    else headerX = ((u8g2->getDisplayWidth() - (u8g2->getUTF8Width(header))) / 2) - 6;
+      // Draw the header at the top
+      int headerWidth = u8g2->getUTF8Width(header);
 
-    u8g2->drawStr(headerX + 2, headerHeight,
-                  header); // Draw header at the top
+      int headerX;
+      if (iconBitmap != NULL) headerX = (Geometry::WIDTH - (u8g2->getUTF8Width(header))) / 2;
+      else headerX = ((Geometry::WIDTH - (u8g2->getUTF8Width(header))) / 2) - 6;
 
-    u8g2->setDrawColor(2);
-    u8g2->drawRBox(headerX, 1, headerWidth + 4, headerHeight + 1,
-                   0); // Draw background for header
-    u8g2->setDrawColor(1);
-    if (iconBitmap != NULL) u8g2->drawXBMP(headerX - 16 - 2, 0, 16, 16, iconBitmap);
+      u8g2->drawStr(headerX + 2, headerHeight,
+                    header); // Draw header at the top
 
-    u8g2->setFont(font);
+      u8g2->setDrawColor(2);
+      u8g2->drawRBox(headerX, 1, headerWidth + 4, headerHeight + 1,
+                     0); // Draw background for header
+      u8g2->setDrawColor(1);
+      if (iconBitmap != NULL) drawIcon(headerX - 16 - 2, 0, 16, 16, iconBitmap);
 
-    // Scroll handle height and position calculation
-    int handleHeight = (64 * visibleItems) / numItems;
-    int handlePosition = ((64 * offset) / numItems);
+      u8g2->setFont(fonts.mono);
 
-    // Draw scrollbar
+      // Scroll handle height and position calculation
+      int handleHeight = (Geometry::HEIGHT * visibleItems) / numItems;
+      int handlePosition = ((Geometry::HEIGHT * offset) / numItems);
 
-    // u8g2->drawRBox(123, 17, 3, 4, 1);
-    u8g2->drawXBMP(120, 0, 8, 64, bitmap_scrollbar_background_full);
-    u8g2->drawRBox(125, handlePosition, 3, handleHeight, 1);
+      // Draw scrollbar
 
-    // Display list items below the header
-    for (int i = 0; i < visibleItems; i++) {
-      int itemIndex = i + offset; // Adjust for scrolling
+      // u8g2->drawRBox(123, 17, 3, 4, 1);
+      drawScrollbar(handlePosition, handleHeight);
 
-      if (itemIndex >= numItems) {
-        break; // Prevent out-of-bound access when at the last item
-      }
+      // Display list items below the header
+      for (int i = 0; i < visibleItems; i++) {
+        int itemIndex = i + offset; // Adjust for scrolling
 
-      char buf[128];
-      switch (displayType) {
-      case ListType::NONE: {
-        strcpy(buf, items[itemIndex]);
-        break;
-      }
-      case ListType::BULLET: {
-        sprintf(buf, "-° %s", items[itemIndex]);
-        break;
-      }
-      case ListType::NUMBER: {
-        sprintf(buf, "%d. %s", itemIndex + 1, items[itemIndex]);
-      }
-      }
+        if (itemIndex >= numItems) {
+          break; // Prevent out-of-bound access when at the last item
+        }
 
-      // Render list items below the header (start from headerHeight)
-      u8g2->drawStr(5, headerHeight + (i + 1) * u8g2->getMaxCharHeight(),
-                    buf); // Display each item
-    }
+        char buf[128];
+        switch (displayType) {
+        case ListType::NONE: {
+          strcpy(buf, items[itemIndex]);
+          break;
+        }
+        case ListType::BULLET: {
+          sprintf(buf, "-° %s", items[itemIndex]);
+          break;
+        }
+        case ListType::NUMBER: {
+          sprintf(buf, "%d. %s", itemIndex + 1, items[itemIndex]);
+        }
+        }
 
-    u8g2->sendBuffer(); // Send buffer to the display
+        // Render list items below the header (start from headerHeight)
+        u8g2->drawStr(5, headerHeight + (i + 1) * u8g2->getMaxCharHeight(),
+                      buf); // Display each item
+      }
+    });
 
     // Handle input actions
     ActionType action = doInput();
@@ -1684,51 +2924,312 @@ void PixelView::listBrowser(const char *header, const unsigned char iconBitmap[]
   } while (true);
 }
 
+void PixelView::drawSpan(int x, int y, const char *text, size_t length, int right) {
+  const int advance = u8g2->getMaxCharWidth();
+  for (size_t i = 0; i < length && x + advance <= right; i++, x += advance) {
+    uint8_t c = text[i];
+    if (c > ' ') u8g2->drawGlyph(x, y, c); // Control characters and tabs as spaces
+  }
+}
+
+#if defined(PIXELVIEW_LOG_FS) || defined(PIXELVIEW_LOG_POSIX)
+void PixelView::drawLogView(const char *header, const char *status, LogFile &log, size_t top, size_t column) {
+  u8g2->setFont(fonts.title);
+  u8g2->drawStr(1, 11, header);
+  u8g2->setFont(fonts.small);
+  u8g2->drawStr(Geometry::SCROLLBAR_X - 1 - u8g2->getStrWidth(status), 11, status);
+
+  u8g2->setFont(fonts.mono);
+  const size_t rows = Geometry::LOG_ROWS;
+  size_t lines = log.lines();
+  for (size_t row = 0; row < rows && top + row < lines; row++) {
+    LogFile::Span line = log.line(top + row);
+    if (line.length <= column) continue;
+    drawSpan(1, Geometry::LOG_FIRST_BASELINE + row * Geometry::LOG_ROW_HEIGHT, line.data + column,
+             line.length - column, Geometry::SCROLLBAR_X - 1);
+  }
+
+  int handleHeight = lines > rows ? std::max(3, (int)(Geometry::HEIGHT * rows / lines)) : Geometry::HEIGHT;
+  int handlePosition = lines > rows ? (double)(Geometry::HEIGHT - handleHeight) * top / (lines - rows) : 0;
+  drawScrollbar(handlePosition, handleHeight);
+}
+
+void PixelView::logViewer(const char *header, LogFile &log, bool follow) {
+  const size_t rows = Geometry::LOG_ROWS;
+  const size_t sideStep = Geometry::LOG_COLUMNS / 2;
+  size_t top = 0;
+  size_t column = 0;
+  char status[24];
+
+  // What the screen shows, to tell what needs redrawing
+  size_t drawnTop = 0;
+  size_t drawnLines = 0;
+  size_t drawnSize = 0;
+  unsigned long lastDraw = 0;
+  unsigned long lastRefresh = 0;
+
+  auto lastTop = [&]() -> size_t { return log.lines() > rows ? log.lines() - rows : 0; };
+  auto scroll = [&](long lines) {
+    if (lines < 0) {
+      top = (size_t)-lines > top ? 0 : top + lines;
+      follow = false;
+    } else {
+      top = std::min(top + lines, lastTop());
+      follow = top == lastTop() && log.indexed();
+    }
+  };
+
+  // Draws the view if `force`d, or if the log grew and nothing was drawn for 100 ms. When the lines shown
+  // didn't change, only the header is sent, for its line count
+  auto render = [&](bool force) {
+    size_t lines = log.lines();
+    if (follow || top > lastTop()) top = lastTop(); // Following, or the log was truncated
+    bool grew = lines != drawnLines || log.size() != drawnSize;
+    unsigned long now = millis();
+    if (!force && !(grew && now - lastDraw >= 100)) return;
+
+    if (log.indexed())
+      snprintf(status, sizeof(status), "%u/%u", (unsigned)std::min(top + rows, lines), (unsigned)lines);
+    else
+      snprintf(status, sizeof(status), "%u%%", (unsigned)((double)log.indexedSize() * 100 / log.size()));
+
+    if (force || top != drawnTop || drawnTop + rows >= drawnLines) {
+      drawFrame([&] { drawLogView(header, status, log, top, column); });
+    } else {
+      Region region = {0, 0, (int16_t)Geometry::WIDTH, 16};
+      drawRegion(region, [&] {
+        clearRegion(region);
+        u8g2->setClipWindow(region.x, region.y, region.x + region.w, region.y + region.h);
+        drawLogView(header, status, log, top, column);
+        u8g2->setMaxClipWindow();
+      });
+    }
+    drawnTop = top;
+    drawnLines = lines;
+    drawnSize = log.size();
+    lastDraw = now;
+  };
+
+  // Index what's already there up to the first screen, so it doesn't open on an empty list
+  while (!log.indexed() && log.lines() <= rows)
+    log.index();
+  render(true);
+
+  while (true) {
+    // Keep indexing between inputs; once done, look for appended lines four times a second
+    if (!log.indexed()) {
+      log.index();
+    } else if (millis() - lastRefresh >= 250) {
+      lastRefresh = millis();
+      log.refresh();
+    }
+    render(false);
+
+    ActionType action = doInput();
+    switch (action) {
+    case ActionType::NONE:
+      if (log.indexed()) doDelay(20);
+      continue;
+
+    case ActionType::UP:
+    case ActionType::DOWN: {
+      long direction = action == ActionType::DOWN ? 1 : -1;
+      scroll(direction);
+      render(true);
+
+      // Held: a page at a time
+      unsigned long pressed = millis();
+      unsigned long lastStep = pressed;
+      while (doInput() == action) {
+        if (millis() - pressed >= 400 && millis() - lastStep >= 100) {
+          lastStep = millis();
+          scroll(direction * (long)rows);
+          render(true);
+        }
+        if (!log.indexed()) log.index();
+        doDelay(20);
+      }
+      continue; // Already released
+    }
+
+    case ActionType::LEFT:
+      column = column > sideStep ? column - sideStep : 0;
+      render(true);
+      break;
+
+    case ActionType::RIGHT: {
+      // Only as far as the longest line shown
+      size_t longest = 0;
+      for (size_t row = 0; row < rows && top + row < log.lines(); row++)
+        longest = std::max(longest, log.line(top + row).length);
+      if (column + Geometry::LOG_COLUMNS < longest) column += sideStep;
+      render(true);
+    } break;
+
+    case ActionType::SEL:
+      while (doInput() == ActionType::SEL)
+        ; // Wait until selection is released
+      return;
+    }
+
+    while (doInput() != ActionType::NONE)
+      doDelay(20);
+  }
+}
+#endif
+
 void PixelView::progressBar(int progress, const char *header, const unsigned char *bitmap[]) {
-  u8g2->clearBuffer();
-  u8g2->setFont(u8g2_font_helvB08_tr);
+  char buf[32];
+  StringUtils::appendStr(StringUtils::appendSigned(buf, progress), "%");
+  drawFrame([&] { drawProgressBar(map(progress, 0, 100, 0, Geometry::WIDTH - 8), header, buf); });
+}
+
+void PixelView::drawProgressBar(int filled, const char *header, const char *label) {
+  u8g2->setFont(fonts.title);
 
   // Calculate header width and position
   int headerWidth = u8g2->getUTF8Width(header);
-  int headerX = (u8g2->getDisplayWidth() - headerWidth) / 2;
+  int headerX = (Geometry::WIDTH - headerWidth) / 2;
   int headerHeight = u8g2->getMaxCharHeight();
 
   // Draw accent text
-  accentText(headerX, headerHeight, header, u8g2_font_helvB08_tr);
+  accentText(headerX, headerHeight, header, fonts.title);
 
   // Draw progress bar frame and filled box
-  u8g2->drawFrame(2, 35, 124, 17);
-  u8g2->drawBox(4, 37, map(progress, 0, 100, 0, 120), 13);
+  u8g2->drawFrame(2, Geometry::PROGRESS_BAR_Y, Geometry::WIDTH - 4, 17);
+  u8g2->drawBox(4, Geometry::PROGRESS_BAR_Y + 2, filled, 13);
 
   // Set font for progress percentage
-  u8g2->setFont(u8g2_font_haxrcorp4089_tr);
+  u8g2->setFont(fonts.small);
 
-  // Display progress percentage
-  char buf[32];
-  sprintf(buf, "%d%%", progress);
+  int textWidth = u8g2->getStrWidth(label);
+  int x = (Geometry::WIDTH - textWidth) / 2; // Centering the text
+  if (Geometry::PROGRESS_TEXT_INSIDE) u8g2->setDrawColor(2);
+  u8g2->drawStr(x, Geometry::PROGRESS_TEXT_Y, label);
+  u8g2->setDrawColor(1);
+}
+
+PixelView::Progress::Progress(PixelView *px, const char *header, bool showEta)
+    : px(px), header(header), showEta(showEta) {}
+
+int PixelView::Progress::filledWidth() const {
+  if (total == 0) return 0;
+  unsigned long clamped = done < total ? done : total;
+  return (int)((unsigned long long)clamped * (Geometry::WIDTH - 8) / total);
+}
+
+void PixelView::Progress::formatLabel(char *out, size_t size) const {
+  int percent = total == 0 ? 0 : (int)((unsigned long long)(done < total ? done : total) * 100 / total);
+  long eta = getEtaSeconds();
+  if (showEta && eta >= 0 && done < total)
+    snprintf(out, size, "%d%%  %ld:%02ld", percent, eta / 60, eta % 60);
+  else snprintf(out, size, "%d%%", percent);
+}
+
+void PixelView::Progress::sample(unsigned long now) {
+  if (sampleAt == 0 || done < sampleDone) {
+    // First sample, or the transfer restarted
+    sampleAt = now;
+    sampleDone = done;
+    rate = 0;
+    return;
+  }
+  if (now - sampleAt < sampleMillis) return;
+
+  // Exponential moving average, weighing each sample by the time it covers so the rate is smoothed over
+  // about 3 s whatever the update frequency
+  float current = (done - sampleDone) * 1000.0f / (now - sampleAt);
+  float weight = (now - sampleAt) / 3000.0f;
+  if (weight > 1) weight = 1;
+  rate = rate == 0 ? current : rate + (current - rate) * weight;
+  sampleAt = now;
+  sampleDone = done;
+}
+
+long PixelView::Progress::getEtaSeconds() const {
+  if (rate <= 0 || done >= total) return done >= total ? 0 : -1;
+  return (long)((total - done) / rate + 0.5f);
+}
+
+bool PixelView::Progress::update(unsigned long done, unsigned long total) {
+  updates++;
+  this->done = done;
+  this->total = total;
+  if (showEta) sample(millis());
+
+  if (!drawn) {
+    redraw();
+    return true;
+  }
+
+  int width = filledWidth();
+  char text[sizeof(label)];
+  formatLabel(text, sizeof(text));
+  bool barChanged = width != filled;
+  bool labelChanged = strcmp(text, label) != 0;
+  if (!barChanged && !labelChanged) return false;
+
+  filled = width;
+  strcpy(label, text);
+  redraws++;
+
+  // Only the tile rows holding what changed are redrawn and sent. The label may sit inside the bar
+  const int barTop = Geometry::PROGRESS_BAR_Y + 2, barBottom = Geometry::PROGRESS_BAR_Y + 14;
+  px->u8g2->setFont(px->fonts.small);
+  int labelTop = Geometry::PROGRESS_TEXT_Y - px->u8g2->getAscent();
+  int labelBottom = Geometry::PROGRESS_TEXT_Y - px->u8g2->getDescent();
+  int top = Geometry::HEIGHT, bottom = 0;
+  if (barChanged) {
+    top = barTop;
+    bottom = barBottom;
+  }
+  if (labelChanged) {
+    top = std::min(top, labelTop);
+    bottom = std::max(bottom, labelBottom);
+  }
+  redrawRows(std::max(top, 0) / 8, std::min(bottom, (int)Geometry::HEIGHT - 1) / 8);
+  return true;
+}
 
-  int textWidth = u8g2->getStrWidth(buf);
-  int x = (u8g2->getDisplayWidth() - textWidth) / 2; // Centering the text
-  u8g2->drawStr(x, 30, buf);
+void PixelView::Progress::redraw() {
+  filled = filledWidth();
+  formatLabel(label, sizeof(label));
+  px->drawFrame([&] { px->drawProgressBar(filled, header, label); });
+  drawn = true;
+}
 
-  // Send buffer to display
-  u8g2->sendBuffer();
+void PixelView::Progress::redrawRows(int firstRow, int lastRow) {
+  Region region = {0, (int16_t)(firstRow * 8), (int16_t)Geometry::WIDTH, (int16_t)((lastRow - firstRow + 1) * 8)};
+  px->drawRegion(region, [&] {
+    // Whole rows of tiles are redrawn, so everything crossing them is drawn again, clipped to the rows
+    px->clearRegion(region);
+    px->u8g2->setClipWindow(region.x, region.y, region.x + region.w, region.y + region.h);
+    px->drawProgressBar(filled, header, label);
+    px->u8g2->setMaxClipWindow();
+  });
 }
 
 void PixelView::progressCircle(int frame) {
-  u8g2->clearBuffer();
-
-  // Define the positions of all ellipses in circular order
-  const int ellipses[][2] = {
-      {63, 20}, // Top
-      {74, 24}, // Upper right
-      {80, 37}, // Middle right
-      {74, 49}, // Lower right
-      {63, 54}, // Bottom
-      {51, 49}, // Lower left
-      {46, 37}, // Middle left
-      {52, 24}  // Upper left
+  drawFrame([&] { drawProgressCircle(frame); });
+}
+
+void PixelView::progressCircleDot(int dot, int &x, int &y) {
+  // Offsets from the centre for a radius of 17, in circular order from the top, scaled to Geometry::CIRCLE_RADIUS
+  static const int8_t ellipses[][2] = {
+      {0, -17},  // Top
+      {11, -13}, // Upper right
+      {17, 0},   // Middle right
+      {11, 12},  // Lower right
+      {0, 17},   // Bottom
+      {-12, 12}, // Lower left
+      {-17, 0},  // Middle left
+      {-11, -13} // Upper left
   };
+  x = Geometry::CIRCLE_X + ellipses[dot][0] * Geometry::CIRCLE_RADIUS / 17;
+  y = Geometry::CIRCLE_Y + ellipses[dot][1] * Geometry::CIRCLE_RADIUS / 17;
+}
+
+void PixelView::drawProgressCircle(int frame) {
   const int numEllipses = 8;
 
   // Calculate which ellipse to fill based on the frame
@@ -1736,14 +3237,117 @@ void PixelView::progressCircle(int frame) {
 
   // Draw all ellipses
   for (int i = 0; i < numEllipses; i++) {
+    int x, y;
+    progressCircleDot(i, x, y);
     if (i == filledEllipseIndex) {
       // Fill only the current ellipse
-      u8g2->drawFilledEllipse(ellipses[i][0], ellipses[i][1], 3, 3);
+      u8g2->drawFilledEllipse(x, y, 3, 3);
     } else {
       // Draw other ellipses as outlines
-      u8g2->drawEllipse(ellipses[i][0], ellipses[i][1], 2, 2);
+      u8g2->drawEllipse(x, y, 2, 2);
     }
   }
+}
+
+PixelView::Spinner::Spinner(PixelView *px, unsigned long periodMillis) : periodMillis(periodMillis), px(px) {}
+
+PixelView::Spinner::~Spinner() { stop(); }
+
+bool PixelView::Spinner::start(const char *message) {
+  stop();
+  this->message = message;
+  frame = 0;
+  px->drawFrame([&] { draw(); });
+
+  stopping = false;
+#if defined(PIXELVIEW_FLUSH_FREERTOS)
+  stopped = xSemaphoreCreateBinary();
+  if (stopped == NULL) return false;
+  if (xTaskCreate(taskMain, "pixelViewSpinner", 3072, this, uxTaskPriorityGet(NULL), &task) != pdPASS) {
+    vSemaphoreDelete(stopped);
+    stopped = NULL;
+    return false;
+  }
+  running = true;
+  return true;
+#elif defined(PIXELVIEW_FLUSH_THREAD)
+  running = true;
+  thread = std::thread(&Spinner::threadMain, this);
+  return true;
+#else
+  return false;
+#endif
+}
+
+void PixelView::Spinner::stop() {
+  if (!running) return;
+#if defined(PIXELVIEW_FLUSH_FREERTOS)
+  stopping = true;
+  xTaskNotifyGive(task);
+  xSemaphoreTake(stopped, portMAX_DELAY);
+  vSemaphoreDelete(stopped);
+  stopped = NULL;
+#elif defined(PIXELVIEW_FLUSH_THREAD)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  wake.notify_all();
+  thread.join();
+#endif
+  running = false;
+}
+
+void PixelView::Spinner::draw() {
+  if (message != NULL && Geometry::HEIGHT >= 64) {
+    px->u8g2->setFont(px->fonts.body);
+    px->u8g2->drawUTF8((Geometry::WIDTH - px->u8g2->getUTF8Width(message)) / 2, 12, message);
+  }
+  px->drawProgressCircle(frame);
+}
+
+void PixelView::Spinner::step() {
+  int previous = frame % 8;
+  frame++;
+  steps++;
+  redrawDot(previous);
+  redrawDot(frame % 8);
+}
 
-  u8g2->sendBuffer();
+void PixelView::Spinner::redrawDot(int dot) {
+  int x, y;
+  px->progressCircleDot(dot, x, y);
+  Region region = {(int16_t)(x - 3), (int16_t)(y - 3), 7, 7};
+  px->drawRegion(region, [&] {
+    // A page buffer sends whole tiles, so whatever else crosses the dot's rows of tiles is drawn again too
+    px->clearRegion(region);
+    if (px->isPageBuffered())
+      px->u8g2->setClipWindow(0, region.y / 8 * 8, Geometry::WIDTH, (region.y + region.h + 7) / 8 * 8);
+    else px->u8g2->setClipWindow(region.x, region.y, region.x + region.w, region.y + region.h);
+    draw();
+    px->u8g2->setMaxClipWindow();
+  });
 }
+
+#if defined(PIXELVIEW_FLUSH_FREERTOS)
+void PixelView::Spinner::taskMain(void *self) {
+  Spinner *spinner = static_cast<Spinner *>(self);
+  while (true) {
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(spinner->periodMillis));
+    if (spinner->stopping) break;
+    spinner->step();
+  }
+  xSemaphoreGive(spinner->stopped);
+  vTaskDelete(NULL);
+}
+#elif defined(PIXELVIEW_FLUSH_THREAD)
+void PixelView::Spinner::threadMain() {
+  std::unique_lock<std::mutex> lock(mutex);
+  while (true) {
+    if (wake.wait_for(lock, std::chrono::milliseconds(periodMillis), [this] { return (bool)stopping; })) break;
+    lock.unlock();
+    step();
+    lock.lock();
+  }
+}
+#endif
@@ -1,8 +1,21 @@
 #pragma once
 
+#include "BitSet.h"
+#include "BusTiming.h"
+#include "FlushTask.h"
+#include "FrameMirror.h"
+#include "Fonts.h"
+#include "Geometry.h"
+#include "InputTrace.h"
+#include "LogFile.h"
+#include "MenuTree.h"
+#include "PackedBitmap.h"
+#include "RingBuffer.h"
+#include "TileBitmap.h"
 #include "actions.h"
 // #include <Arduino.h>
 #include <U8g2lib.h>
+#include <algorithm>
 #include <functional>
 
 #if defined(ARDUINO)
@@ -19,11 +32,8 @@
 #define PAGE_NONE_NAV 5
 
 /* IDEAS:
- *    - Have some 'non-blocking' functions for Pager
  *    - Vertical indicator for Pager
  *
- *    - Carousel view with big icons (64x64 maybe)
- *
  * */
 
 /**
@@ -35,6 +45,19 @@ class PixelView {
 public:
   typedef std::function<ActionType(void)> InputFuncType;
 
+  /**
+   * @brief A rectangle on the display, in pixels
+   */
+  struct Region {
+    int16_t x;
+    int16_t y;
+    int16_t w;
+    int16_t h;
+  };
+
+  class LatencyProbe;
+  class IdleManager;
+
 private:
   /**
    * @brief Pointer to a U8G2 object
@@ -47,23 +70,489 @@ private:
   void search(const String items[], const size_t numItems, const char *query, const char *result[], size_t *resultCount,
               size_t resultIndices[], bool caseSensitive = true);
 
-  const uint8_t *font;
+  /**
+   * @brief true if the U8G2 buffer holds the whole frame in the SSD1306/SH1106 layout (8 vertical pixels
+   *        per byte, rows of 8x8 tiles) with no rotation, so it can be manipulated directly
+   */
+  bool hasVerticalTileBuffer();
+
+  /**
+   * @brief Moves the pixels inside `region` `dx` columns to the left in the buffer, clearing the
+   *        uncovered columns on the right. Nothing is sent to the display.
+   * @return false if the buffer layout isn't supported (see hasVerticalTileBuffer)
+   */
+  bool shiftRegionLeft(const Region &region, int dx);
+
+  // Draw settings each page of a page buffer frame starts from, so every pass draws the same thing
+  struct DrawState {
+    const uint8_t *font;
+    uint8_t drawColor;
+    uint8_t bitmapMode;
+  };
+  DrawState saveDrawState();
+  void restoreDrawState(const DrawState &state);
+
+  /**
+   * @brief Sends the tiles of `region` that lie in the current page of a page buffer
+   */
+  void sendPageRegion(const Region &region);
+
+  /**
+   * @brief Copies a w x h TileBitmap image into the buffer a byte at a time, following the draw color, bitmap
+   *        mode and clip window like drawXBMP(). Falls back to drawing pixels when the buffer isn't in the
+   *        vertical tile layout or the draw color isn't 1
+   * @param progmem true if `data` is in PROGMEM, false if it's in RAM
+   */
+  void blitTiles(int x, int y, uint8_t w, uint8_t h, const uint8_t *data, bool progmem);
+
+  /**
+   * @brief The body of progressBar(): `header`, the bar filled `filled` pixels and `label` (e.g. "42%")
+   */
+  void drawProgressBar(int filled, const char *header, const char *label);
+
+  /**
+   * @brief The body of progressCircle(): eight dots, dot `frame % 8` filled
+   */
+  void drawProgressCircle(int frame);
+
+  /**
+   * @brief Centre of dot `dot` (0 at the top, clockwise) of progressCircle()
+   */
+  void progressCircleDot(int dot, int &x, int &y);
+
+#if defined(PIXELVIEW_LOG_FS) || defined(PIXELVIEW_LOG_POSIX)
+  /**
+   * @brief The body of logViewer(): the header, `status` and Geometry::LOG_ROWS lines from `top`, scrolled
+   *        `column` characters to the right
+   */
+  void drawLogView(const char *header, const char *status, LogFile &log, size_t top, size_t column);
+#endif
+
+  /**
+   * @brief Draws `length` characters of `text` in a monospaced font from `x`, without needing a NUL, up to `right`
+   */
+  void drawSpan(int x, int y, const char *text, size_t length, int right);
+
+  /**
+   * @brief The cells of gridMenu() from row `top`, and its scroll handle. Only cells crossing the clip window and
+   *        the current page are drawn, so `iconAt` isn't called for the others
+   * @param streamed The icons come from an IconSourceType, so the cache recognises them by index, not address
+   */
+  void drawGrid(const std::function<const unsigned char *(size_t)> &iconAt, size_t numItems, int top, int selected,
+                bool streamed);
+
+  /**
+   * @brief Both gridMenu()s. `streamed` is passed on to drawGrid()
+   */
+  int iconGrid(const std::function<const unsigned char *(size_t)> &iconAt, size_t numItems, int selected,
+               bool streamed);
+
+  /**
+   * @brief Where gridMenu() draws the selection box of cell `index` when row `top` is the first one shown
+   */
+  Region gridCell(int index, int top);
+
+  /**
+   * @brief The body of checkBoxes(): the header, Geometry::CHECK_ROWS items from `startIndex` and the scrollbar.
+   *        `status`, if not NULL, is drawn at the right of the header. `marked` rows get a dot on the left
+   */
+  template <typename C, typename N, typename M>
+  void drawCheckList(const char *header, const char *status, size_t numItems, int startIndex, int selected,
+                     int handlePosition, int handleHeight, C isChecked, N nameAt, M marked) {
+    // Draw header
+    u8g2->setFont(fonts.title);
+    int headerWidth = u8g2->getUTF8Width(header);
+    int headerX = (Geometry::WIDTH - (u8g2->getUTF8Width(header))) / 2;
+    int headerHeight = u8g2->getMaxCharHeight(); // Assuming header takes up one line
+
+    u8g2->drawStr(headerX + 2, headerHeight,
+                  header); // Draw header at the top
+
+    u8g2->setDrawColor(2);
+    u8g2->drawRBox(headerX, 1, headerWidth + 4, headerHeight + 1,
+                   0); // Draw background for header
+    u8g2->setDrawColor(1);
+
+    // Draw menu items
+    u8g2->setFont(fonts.small);
+    if (status != NULL) u8g2->drawStr(Geometry::SCROLLBAR_X - 1 - u8g2->getStrWidth(status), headerHeight, status);
+
+    for (int i = 0; i < Geometry::CHECK_ROWS && (size_t)(startIndex + i) < numItems; i++) {
+      int itemIndex = startIndex + i;
+
+      // // Draw frame for all items
+      u8g2->drawFrame(5, 17 + (i * 11), 9, 9);
+
+      // Draw filled box for selected item
+
+      if (isChecked(itemIndex)) {
+        u8g2->drawBox(7, 19 + (i * 11), 5, 5);
+      }
+
+      if (itemIndex == selected) {
+        u8g2->setDrawColor(2);
+        u8g2->drawBox(8, 20 + (i * 11), 3, 3);
+        u8g2->setDrawColor(1);
+      }
+
+      if (marked(itemIndex)) u8g2->drawBox(1, 20 + (i * 11), 2, 3);
+
+      u8g2->drawStr(18, 25 + (i * 11), nameAt(itemIndex));
+    }
+
+    drawScrollbar(handlePosition, handleHeight);
+  }
+
+  /**
+   * @brief Draws the scrollbar track on the right edge and its handle
+   */
+  void drawScrollbar(int handleY, int handleHeight);
+
+  /**
+   * @brief Draws the rounded outline around the selected row of menu(), whose top is at `y`
+   */
+  void drawSelectionOutline(int y);
+
+  /**
+   * @brief The body of subMenu() and searchList(): the header, Geometry::LIST_ROWS items centred on the selected one
+   *        and the scrollbar. `itemAt(i)` returns the text of item i
+   */
+  template <typename F> void drawScrollList(const char *header, int count, int selected, int minHandle, F itemAt) {
+    u8g2->setDrawColor(1);
+    int handleHeight = std::max(minHandle, (int)(Geometry::HEIGHT / count));
+    drawScrollbar((double)Geometry::HEIGHT / count * selected, handleHeight);
+
+    u8g2->setFont(fonts.title);
+    u8g2->drawStr(1, 11, header);
+
+    u8g2->setFont(fonts.body);
+    const int center = Geometry::LIST_ROWS / 2;
+    for (int row = 0; row < Geometry::LIST_ROWS; row++) {
+      int item = ((selected + row - center) % count + count) % count;
+      u8g2->drawStr(8, Geometry::LIST_FIRST_BASELINE + row * Geometry::LIST_ROW_HEIGHT, itemAt(item));
+    }
+
+    u8g2->setDrawColor(2);
+    u8g2->drawRBox(2, Geometry::LIST_FIRST_BASELINE + center * Geometry::LIST_ROW_HEIGHT - 11,
+                   Geometry::LIST_HIGHLIGHT_WIDTH, 15, 1);
+  }
+
+  /**
+   * @brief The body of menu() and menuLevel(): Geometry::MENU_ROWS icons and names centred on the selected one, the
+   *        selection outline and the scrollbar. `nameAt(i)` and `iconAt(i)` return the text and icon of item i
+   */
+  template <typename F, typename G> void drawIconMenu(int count, int selected, F nameAt, G iconAt) {
+    u8g2->setBitmapMode(1);
+
+    // Geometry::MENU_ROWS items with the selected one in the middle, wrapping around
+    const int center = Geometry::MENU_ROWS / 2;
+    for (int row = 0; row < Geometry::MENU_ROWS; row++) {
+      int item = ((selected + row - center) % count + count) % count;
+      int top = Geometry::MENU_TOP + row * Geometry::MENU_ROW_HEIGHT;
+
+      drawIcon(4, top + 2, 16, 16, iconAt(item));
+
+      // Draw the selected item with a bold font
+      u8g2->setFont(row == center ? fonts.title : fonts.body);
+      u8g2->drawStr(row < center ? 24 : 25, top + 15, nameAt(item));
+    }
+
+    drawSelectionOutline(Geometry::MENU_TOP + center * Geometry::MENU_ROW_HEIGHT);
+
+    u8g2->setDrawColor(1);
+    drawScrollbar(Geometry::HEIGHT / count * selected, Geometry::HEIGHT / count);
+  }
+
+  // Icons converted to TileBitmap on first use, see setIconCache()
+  struct IconSlot {
+    const uint8_t *xbm;
+    size_t index;  // For icons from an IconSourceType, which may all be streamed into the same buffer
+    bool streamed; // Recognised by `index` instead of `xbm`
+    uint8_t width;
+    uint8_t height;
+    unsigned long lastUsed;
+    uint8_t tiles[32];
+  };
+  IconSlot *iconCache = NULL;
+  size_t iconSlots = 0;
+  unsigned long iconClock = 0;
+
+  /**
+   * @brief drawIcon() for the cache: an icon from an IconSourceType (`streamed`) is looked up by `index`
+   */
+  void drawCachedIcon(int x, int y, uint8_t w, uint8_t h, const uint8_t *xbm, bool streamed, size_t index);
+
+  /**
+   * @brief Empties the slots of streamed icons, whose indices only mean something to the IconSourceType they came from
+   */
+  void forgetStreamedIcons();
+
+  FlushTask *flusher = NULL;
+
+  /**
+   * @brief Sends the whole buffer, through the flush task when asynchronous flushing is enabled
+   */
+  void sendFrame();
+
+  /**
+   * @brief Accounts for `tw` x `th` tiles just sent or queued: updates stats and tells the latency probe when
+   *        they reach the display. On the host, also waits as long as the transfer takes on the simulated bus
+   */
+  void sent(uint8_t tw, uint8_t th, bool frame);
+
+  /**
+   * @brief sent() for the tiles covering `region`
+   */
+  void sentRegion(const Region &region);
+
+  BusTiming busTiming;
+  unsigned long busFreeAt = 0; // When the simulated bus finishes the transfers queued so far, in micros()
+
+  LatencyProbe *probe = NULL;
+
+  FrameMirror *mirror = NULL;
+
+  IdleManager *idle = NULL;
+
+  bool prefetching = false; // A Pager is rendering a page off-screen: nothing is sent, mirrored or counted
+
+  /**
+   * @brief FNV-1a of the buffer (the current page with a page buffer), continuing from `hash`
+   */
+  uint32_t hashBuffer(uint32_t hash = 2166136261u);
+
+  /**
+   * @brief Passes tiles tx..tx+tw, ty..ty+th of the buffer, which are being sent, to the mirror
+   */
+  void mirrorTiles(uint8_t tx, uint8_t ty, uint8_t tw, uint8_t th);
 
 public:
   InputFuncType doInput;
   std::function<void(int32_t)> doDelay;
 
+  /**
+   * @brief The fonts widgets draw with, by role. Replace any of them to restyle every widget using it
+   */
+  FontSet fonts;
+
+  /**
+   * @brief What has been sent to the display since construction (or since you last reset it)
+   */
+  struct FlushStats {
+    unsigned long frames = 0;  // Whole frames, from drawFrame() and the widgets
+    unsigned long regions = 0; // Partial updates, from drawRegion() and flushRegion()
+    unsigned long bytes = 0;   // Frame buffer bytes sent by both, 8 per tile
+  };
+  FlushStats stats;
+
+  /**
+   * @class LatencyProbe
+   * @brief Measures input-to-photon latency: from the poll where doInput() first returns a new action to the
+   *        moment the last byte of the next frame or region sent reaches the display
+   *
+   * It wraps doInput while it exists. With asynchronous flushing the end of the transfer is estimated from
+   * setBusTiming(), so set the bus. Presses that come before the previous one was answered are folded into it.
+   *
+   * ```cpp
+   * pv.setBusTiming(BusTiming::i2c(400000));
+   * PixelView::LatencyProbe probe(&pv);
+   * probe.budgetMicros = 50000;
+   * pv.menu(items, 5);
+   * probe.report("menu", [](const char *line) { puts(line); });
+   * ```
+   */
+  class LatencyProbe {
+  public:
+    struct Stats {
+      unsigned long count = 0;
+      unsigned long min = 0;
+      unsigned long max = 0;
+      unsigned long long total = 0;
+      unsigned long overBudget = 0; // Samples above budgetMicros
+
+      unsigned long average() const { return count ? (unsigned long)(total / count) : 0; }
+    };
+
+    explicit LatencyProbe(PixelView *pixelView);
+    LatencyProbe(const LatencyProbe &) = delete;
+    LatencyProbe &operator=(const LatencyProbe &) = delete;
+    ~LatencyProbe();
+
+    /**
+     * @brief Latency of each action, indexed by (int)ActionType, in microseconds
+     */
+    Stats actions[(int)ActionType::NONE];
+    Stats all;
+
+    /**
+     * @brief Samples above this many microseconds are counted in Stats::overBudget. 0 for no budget
+     */
+    unsigned long budgetMicros = 0;
+
+    /**
+     * @brief Called with every sample
+     */
+    std::function<void(ActionType action, unsigned long micros)> onSample;
+
+    bool withinBudget() const { return all.overBudget == 0; }
+
+    /**
+     * @brief Forgets every sample and any press waiting for its frame
+     */
+    void reset();
+
+    /**
+     * @brief Writes one line per action with samples, and the total, prefixed with `name`
+     */
+    void report(const char *name, std::function<void(const char *line)> out) const;
+
+  private:
+    friend class PixelView;
+
+    PixelView *px;
+    InputFuncType wrapped;
+    ActionType last = ActionType::NONE;
+    bool waiting = false; // A press hasn't been answered by a frame yet
+    ActionType pressed = ActionType::NONE;
+    unsigned long pressedAt = 0;
+
+    ActionType poll();
+    void frameSent(unsigned long doneMicros);
+    void add(Stats &stats, unsigned long latency);
+  };
+
+  /**
+   * @class IdleManager
+   * @brief Stops sending frames that didn't change, then dims the display and puts it to sleep when nobody uses it
+   *
+   * Widgets like listBrowser() redraw the same frame in a loop while waiting for input. Once frames have been
+   * identical and no input came for `suspendAfter` ms, drawFrame() still renders them but only sends those that
+   * differ. After `dimAfter` ms without input the contrast drops to `dimContrast`, and after `sleepAfter` ms the
+   * display is switched off with setPowerSave(1) and nothing is sent. The first input then wakes it up and is
+   * consumed: widgets don't see it, so a press on a dark screen doesn't select anything.
+   *
+   * It wraps doInput while it exists, like LatencyProbe. Timeouts of 0 disable that stage.
+   *
+   * ```cpp
+   * PixelView::IdleManager idle(&pv, 2000, 20000, 60000);
+   * pv.listBrowser(...);
+   * printf("active %lu ms, idle %lu ms\n", idle.activeMillis(), idle.idleMillis());
+   * ```
+   */
+  class IdleManager {
+  public:
+    enum class State : uint8_t { ACTIVE, SUSPENDED, DIMMED, ASLEEP };
+
+    IdleManager(PixelView *pixelView, unsigned long suspendAfter = 1000, unsigned long dimAfter = 15000,
+                unsigned long sleepAfter = 60000);
+    IdleManager(const IdleManager &) = delete;
+    IdleManager &operator=(const IdleManager &) = delete;
+    ~IdleManager(); // Wakes the display up
+
+    unsigned long suspendAfter;
+    unsigned long dimAfter;
+    unsigned long sleepAfter;
+
+    uint8_t contrast = 0xCF; // Restored on wake up: the SSD1306 default unless you call setContrast() yourself
+    uint8_t dimContrast = 0x08;
+
+    /**
+     * @brief Wakes the display up as if there had been input, e.g. for an alarm
+     */
+    void wake();
+
+    State getState() const { return state; }
+
+    /**
+     * @brief Time spent in `state` since construction, including the current stretch
+     */
+    unsigned long millisIn(State state) const;
+    unsigned long activeMillis() const { return millisIn(State::ACTIVE); }
+    unsigned long idleMillis() const;
+
+    unsigned long framesSkipped = 0;  // Frames and regions not sent because they were unchanged or the display slept
+    unsigned long inputsConsumed = 0; // Inputs that only woke the display up
+
+  private:
+    friend class PixelView;
+
+    PixelView *px;
+    InputFuncType wrapped;
+    State state = State::ACTIVE;
+    unsigned long stateSince;
+    unsigned long lastInput;
+    unsigned long lastChange; // Last frame or region with new content
+    unsigned long spent[4] = {0, 0, 0, 0};
+    uint32_t lastHash = 0;
+    bool swallowing = false; // The input that woke the display is still held
+
+    ActionType poll();
+    void update(unsigned long now);
+    void enter(State next, unsigned long now);
+
+    /**
+     * @brief Whether a frame whose buffer hashes to `hash` should be sent
+     */
+    bool frameReady(uint32_t hash);
+
+    /**
+     * @brief Whether a region should be sent: it holds new content, so anything but sleep lets it through
+     */
+    bool regionReady();
+  };
+
   /**
    * @brief The constructor
    *
    * @param display is a pointer to an object of type U8G2
    * @param inputFunction A function that returns any ActionType
    * @param delayer A function that delays for n milliseconds
+   * @param font The default text font, stored as `fonts.mono`
    *
    * @returns void
    */
   PixelView(U8G2 *display, std::function<ActionType(void)> inputFunction, std::function<void(int)> delayer,
-            const uint8_t font[] = u8g2_font_6x12_tr);
+            const uint8_t font[] = PIXELVIEW_FONT_MONO);
+  PixelView(const PixelView &) = delete;
+  PixelView &operator=(const PixelView &) = delete;
+  ~PixelView();
+
+  /**
+   * @brief Sends frames from a background task (FreeRTOS on ESP32, a thread on the host) so drawing and
+   *        input continue while the previous frame is on the bus. Costs a second frame buffer (1 KB on 128x64)
+   *
+   * Frames are copied before being sent and only one is in flight, so frames are never torn. If you talk to
+   * the display directly (sendBuffer(), setContrast(), ...) call waitFlush() first.
+   *
+   * @returns false if the display has no full frame buffer or the task couldn't be started
+   */
+  bool setAsyncFlush(bool enabled);
+
+  /**
+   * @brief Returns once every frame drawn so far has been sent to the display
+   */
+  void waitFlush();
+
+  /**
+   * @brief The flush task, or NULL if asynchronous flushing is off
+   */
+  FlushTask *getFlushTask() { return flusher; }
+
+  /**
+   * @brief The display bus, e.g. BusTiming::i2c(400000) or BusTiming::spi(8000000)
+   *
+   * On the host every transfer then takes as long as it would on that bus, asynchronous or not, so benchmarks
+   * include the cost of moving bytes. On the device it only lets LatencyProbe estimate when frames sent by the
+   * flush task reach the display.
+   */
+  void setBusTiming(const BusTiming &timing);
+  const BusTiming &getBusTiming() const { return busTiming; }
+
+  /**
+   * @brief Streams everything sent to the display to `mirror` too, as changed tiles. NULL stops mirroring
+   * @return false if the mirror couldn't allocate its copy of the screen
+   */
+  bool setMirror(FrameMirror *mirror);
 
   /**
    * @brief  Renders text with word wrapping enabled.
@@ -86,6 +575,143 @@ public:
    */
   void accentText(int x, int y, const char *text, const uint8_t font[]);
 
+  /**
+   * @brief Draws a bitmap in the display's native layout (see TileBitmap), which is copied into the buffer
+   *        whole bytes at a time instead of pixel by pixel like drawXBMP(). Follows the draw color, bitmap
+   *        mode and clip window like drawXBMP()
+   */
+  void drawTileBitmap(int x, int y, const TileBitmap &bitmap);
+
+  /**
+   * @brief Converts a PROGMEM XBM image to the TileBitmap layout
+   *
+   * @param tiles Receives TileBitmap::bytesFor(width, height) bytes
+   */
+  static void convertXBM(uint8_t width, uint8_t height, const uint8_t *xbm, uint8_t *tiles);
+
+  /**
+   * @brief convertXBM() for icons that may also be PackedBitmaps. A PackedBitmap of another size leaves `tiles`
+   *        blank
+   */
+  static void decodeIcon(uint8_t width, uint8_t height, const uint8_t *icon, uint8_t *tiles);
+
+  /**
+   * @brief Draws a PackedBitmap (see tools/xbm2tiles.py --pack), decoding it a tile row at a time straight into the
+   *        buffer. Follows the draw color, bitmap mode and clip window like drawTileBitmap()
+   */
+  void drawPackedBitmap(int x, int y, const uint8_t *packed);
+
+  /**
+   * @brief Keeps the last `slots` XBM or PackedBitmap icons (up to 16x16) drawn by menus, gridMenu, listBrowser and
+   *        StatusIcon converted to TileBitmap, so they're drawn with drawTileBitmap(). Costs about 40 bytes per slot.
+   *        0 turns the cache off and icons are drawn with drawXBMP()
+   *
+   * @returns false if the cache couldn't be allocated
+   */
+  bool setIconCache(size_t slots);
+
+  /**
+   * @brief drawXBMP() that goes through the icon cache when it's enabled and the icon fits in a slot. `xbm` may
+   *        also be a PackedBitmap, whose own size is then used
+   */
+  void drawIcon(int x, int y, uint8_t w, uint8_t h, const uint8_t *xbm);
+
+  /**
+   * @brief Clears a region of the buffer (draw color 0) without sending anything
+   */
+  void clearRegion(const Region &region);
+
+  /**
+   * @brief Sends only the 8x8 tiles covering `region` to the display instead of the full buffer
+   *
+   * @note Only works with full buffer (_F_) U8G2 constructors
+   */
+  void flushRegion(const Region &region);
+
+  /**
+   * @brief true if the display was created with a page buffer (_1_/_2_) U8G2 constructor, which only holds
+   *        one or two 8 pixel rows of the frame in RAM (128 or 256 bytes on a 128x64 display)
+   */
+  bool isPageBuffered();
+
+  /**
+   * @brief Draws and sends a whole frame
+   *
+   * With a full buffer this is clearBuffer(), `pass()` and sendBuffer(). With a page buffer `pass` is
+   * replayed for every page (firstPage()/nextPage()), each time starting from the same font, draw color
+   * and bitmap mode. `pass` must therefore only draw: read input and change state before calling this.
+   *
+   * @param pass A function (usually a lambda) that draws the frame
+   */
+  template <typename F> void drawFrame(F pass) {
+    if (!isPageBuffered()) {
+      u8g2->clearBuffer();
+      pass();
+      if (!prefetching && (idle == NULL || idle->frameReady(hashBuffer()))) sendFrame();
+      return;
+    }
+
+    DrawState state = saveDrawState();
+    bool checked = false;
+    if (idle != NULL && idle->getState() != IdleManager::State::ACTIVE) {
+      // nextPage() sends each page as it goes, so find out first whether the frame changed without sending it
+      uint32_t hash = 2166136261u;
+      for (int row = 0; row * 8 < u8g2->getDisplayHeight(); row += u8g2->getBufferTileHeight()) {
+        if (idle->getState() == IdleManager::State::ASLEEP) break; // Won't be sent anyway
+        u8g2->setBufferCurrTileRow(row);
+        u8g2->clearBuffer();
+        restoreDrawState(state);
+        pass();
+        hash = hashBuffer(hash);
+      }
+      u8g2->setBufferCurrTileRow(0);
+      if (!idle->frameReady(hash)) return;
+      checked = true;
+    }
+
+    uint32_t hash = 2166136261u;
+    u8g2->firstPage();
+    do {
+      restoreDrawState(state);
+      pass();
+      if (idle != NULL) hash = hashBuffer(hash);
+      mirrorTiles(0, u8g2->getBufferCurrTileRow(), u8g2->getBufferTileWidth(), u8g2->getBufferTileHeight());
+    } while (u8g2->nextPage());
+    if (idle != NULL && !checked) idle->frameReady(hash);
+    sent(u8g2->getBufferTileWidth(), u8g2->getDisplayHeight() / 8, true);
+  }
+
+  /**
+   * @brief Draws `region` and sends only the tiles covering it
+   *
+   * With a full buffer `pass` draws into the buffer once and, if `flush` is set, the region is sent with
+   * flushRegion(). With a page buffer `pass` is replayed for each page the region spans and those tiles are
+   * always sent. Since a page buffer doesn't remember the rest of the screen, pixels sharing an 8x8 tile
+   * with the region are cleared: keep regions aligned to 8 pixels on such displays.
+   */
+  template <typename F> void drawRegion(const Region &region, F pass, bool flush = true) {
+    if (!isPageBuffered()) {
+      pass();
+      if (flush) flushRegion(region);
+      return;
+    }
+
+    if (idle != NULL && !idle->regionReady()) return;
+    int rows = u8g2->getBufferTileHeight();
+    int bottom = region.y + region.h;
+    if (bottom > u8g2->getDisplayHeight()) bottom = u8g2->getDisplayHeight();
+    DrawState state = saveDrawState();
+    for (int row = (region.y > 0 ? region.y : 0) / 8; row * 8 < bottom; row += rows) {
+      u8g2->setBufferCurrTileRow(row);
+      u8g2->clearBuffer();
+      restoreDrawState(state);
+      pass();
+      sendPageRegion(region);
+    }
+    sentRegion(region);
+    u8g2->setBufferCurrTileRow(0);
+  }
+
   /**
    * @brief Shows a dialog box with two buttons: Yes and No
    * @param message displayed on the screen before the buttons
@@ -101,6 +727,11 @@ public:
    */
   void showMessage(const char *message);
 
+  /**
+   * @brief Shows `message` on a frame of its own and returns at once, without a button or waiting for input
+   */
+  void showText(const char *message);
+
   /**
    * @class Keyboard
    * @brief A (gboard-like) keyboard for OLEDs
@@ -202,7 +833,8 @@ public:
    */
   class Pager {
   public:
-    enum class IndicatorType { DOT, NUM, NUM_ARROW, ARROW, NONE }; // Types of indicators
+    // Types of indicators. DOT shows "n of m" (like NUM) when there are more pages than dots fit on the display
+    enum class IndicatorType { DOT, NUM, NUM_ARROW, ARROW, NONE };
 
     enum class PagerActionType {
       EXIT,
@@ -217,19 +849,85 @@ public:
     typedef std::function<PagerActionType(U8G2 *disp, PixelView *pv, Page *pages, const size_t numPages)>
         PageFuncType; // Function type for each 'page'
 
+    /**
+     * @brief How often a page needs to be re-rendered
+     *
+     * STATIC pages are rendered when they are shown, when they are invalidated and when a (non-navigation)
+     * input arrives, so pages that read doInput() still react. ANIMATED pages are rendered every frame.
+     */
+    enum class Refresh { STATIC, ANIMATED };
+
     struct Page {
       bool enabled;
       PageFuncType renderer;
+      Refresh refresh;
+      bool isVolatile; // Never pre-rendered, e.g. pages that read input or show the time
+      bool dirty;      // Set to have the page re-rendered on the next poll()
+      // Age in ms after which a pre-rendered frame of the page is rendered again. 0 uses the Pager's prefetchMaxAgeMS
+      unsigned long maxAgeMS;
+
+      Page() : enabled(false), refresh(Refresh::ANIMATED), isVolatile(false), dirty(true), maxAgeMS(0) {}
+      Page(bool enabled, PageFuncType renderer, Refresh refresh = Refresh::ANIMATED, bool isVolatile = false,
+           unsigned long maxAgeMS = 0)
+          : enabled(enabled), renderer(renderer), refresh(refresh), isVolatile(isVolatile), dirty(true),
+            maxAgeMS(maxAgeMS) {}
+
+      /**
+       * @brief Marks the page for re-rendering, e.g. when data a STATIC page shows has changed
+       */
+      void invalidate() { dirty = true; }
     };
 
   private:
     size_t index = 0;
     PixelView *px;
 
+    bool navEnabled = true;
+    ActionType lastInput = ActionType::NONE;
+    unsigned long lastFrameMS = 0;
+
+    // The indicator is only laid out again when the visible page or the number of enabled pages changes
+    char indicatorText[64];
+    const uint8_t *indicatorFont = NULL;
+    int indicatorX = 0;
+    size_t indicatorIndex = 0;
+    size_t indicatorCount = 0;
+
+    // Off-screen frames of the neighbouring pages, see setPrefetch()
+    struct PrefetchSlot {
+      uint8_t *buffer = NULL;
+      size_t page = 0;
+      bool valid = false;
+      unsigned long renderedMS = 0;
+      PagerActionType action = PagerActionType::CONTINUE;
+    };
+    PrefetchSlot prefetchSlots[2];
+    size_t prefetchBufferSize = 0;
+
+    size_t adjacentPage(size_t from, bool forward) const;
+    bool selectPage(bool forward);
+    void layoutIndicator(size_t currentEnabledIndex, size_t enabledCount);
+    void drawIndicator();
+    void applyAction(PagerActionType action);
+    PrefetchSlot *findPrefetched(size_t page, unsigned long now);
+    bool prefetchTick(unsigned long now);
+
   public:
     IndicatorType indicator;
     Page *pages;
     size_t numPages;
+
+    /**
+     * @brief Minimum time between two frames of an ANIMATED page, in ms
+     */
+    unsigned long frameMS = 0;
+
+    /**
+     * @brief Age after which a pre-rendered page is rendered again, in ms, for pages without their own `maxAgeMS`.
+     *        0 keeps it until the page is invalidated
+     */
+    unsigned long prefetchMaxAgeMS = 0;
+
     /**
      * @constructor
      *
@@ -241,6 +939,22 @@ public:
      */
 
     Pager(PixelView *px, const size_t numPages, Page *pages, const IndicatorType indicatorType = IndicatorType::DOT);
+    Pager(const Pager &) = delete;
+    Pager &operator=(const Pager &) = delete;
+    ~Pager();
+
+    /**
+     * @brief Pre-renders the previous and next enabled pages into off-screen buffers while poll() is idle,
+     *        so switching to them only copies the buffer and flushes it
+     *
+     * Needs a full frame buffer display and allocates two extra frame buffers (1 KB each on a 128x64 display).
+     * Pages are rendered ahead of time without input, so mark pages that react to input or show
+     * live data with `isVolatile`, or give them a `maxAgeMS` (or set `prefetchMaxAgeMS` for all of them).
+     * What a page sends while pre-rendered, e.g. a BoundWidget's update(), is dropped: it shows with the page.
+     *
+     * @returns false if the display has no full frame buffer or the memory couldn't be allocated
+     */
+    bool setPrefetch(bool enabled);
 
     /**
      * @brief Render the current page and manage input
@@ -248,13 +962,432 @@ public:
      */
     PagerActionType render();
 
+    /**
+     * @brief Handles input and renders the current page only if it needs it. Never blocks, so it can be
+     *        called from your own loop() between other work
+     * @returns the ActionType returned by the page, or CONTINUE if nothing was rendered
+     */
+    PagerActionType poll();
+
+    /**
+     * @brief Marks the current page for re-rendering
+     */
+    void invalidate();
+
     /**
      * @brief Loops till functions return PAGER_EXIT
-     * @param delay ms to wait  between calling render();
+     * @param delay ms to wait  between calling poll();
      */
     void loop(int delay = 20);
   };
 
+  /**
+   * @class BoundValue
+   * @brief Where a bound widget reads its value from: a pointer to any number or a getter function
+   *
+   *   float temperature;
+   *   PixelView::Readout a(&pv, {0, 0, 64, 16}, &temperature);
+   *   PixelView::Readout b(&pv, {64, 0, 64, 16}, []() { return readSensor(); });
+   */
+  struct BoundValue {
+    std::function<float(void)> get;
+
+    template <typename T> BoundValue(T *value) : get([value]() { return static_cast<float>(*value); }) {}
+    template <typename R> BoundValue(R (*getter)()) : get([getter]() { return static_cast<float>(getter()); }) {}
+    template <typename F> BoundValue(F getter) : get(getter) {}
+  };
+
+  /**
+   * @class BoundWidget
+   * @brief Base for widgets that own a region and only redraw it when their bound value changes
+   *
+   * Call update() as often as you like (e.g. from a Pager page or loop()); the widget samples its
+   * value and, if it changed enough to alter what is shown, redraws and flushes only its region.
+   */
+  class BoundWidget {
+  public:
+    BoundWidget(PixelView *px, Region region) : region(region), px(px) {}
+    virtual ~BoundWidget() {}
+
+    /**
+     * @brief Samples the bound value and redraws the widget if needed
+     * @param flush Send the region to the display after redrawing
+     * @return true if the widget was redrawn
+     */
+    bool update(bool flush = true);
+
+    /**
+     * @brief Forces a full redraw on the next update()
+     */
+    virtual void invalidate() { dirty = true; }
+
+    /**
+     * @brief Calls update() on every widget
+     * @return The number of widgets that were redrawn
+     */
+    static size_t updateAll(BoundWidget *widgets[], const size_t numWidgets, bool flush = true);
+
+    Region region;
+
+  protected:
+    /**
+     * @brief Samples the bound value
+     * @return true if the visible output would change
+     */
+    virtual bool sample() = 0;
+
+    /**
+     * @brief Draws the widget inside `region`. The region is already cleared
+     */
+    virtual void draw(U8G2 *disp) = 0;
+
+    /**
+     * @brief Brings the widget's region up to date in the buffer. By default clears the region and calls
+     *        draw(); widgets that can update part of their region override this
+     */
+    virtual void redraw();
+
+    PixelView *px;
+    bool dirty = true;
+  };
+
+  /**
+   * @class Readout
+   * @brief A number with an optional label and unit, e.g. "Temp 21.5C"
+   */
+  class Readout : public BoundWidget {
+  public:
+    /**
+     * @param region Where to draw. The text baseline is placed at the bottom of the region
+     * @param value The bound value
+     * @param decimals Digits after the decimal point
+     * @param threshold Minimum change of the value before the readout is redrawn
+     * @param label Text drawn before the value (optional)
+     * @param unit Text drawn after the value (optional)
+     */
+    Readout(PixelView *px, Region region, BoundValue value, unsigned char decimals = 0, float threshold = 0,
+            const char *label = NULL, const char *unit = NULL, const uint8_t *font = PIXELVIEW_FONT_SMALL);
+
+  protected:
+    bool sample() override;
+    void draw(U8G2 *disp) override;
+
+  private:
+    BoundValue value;
+    unsigned char decimals;
+    float threshold;
+    float shown = 0;
+    long shownPrinted = 0;
+    const char *label;
+    const char *unit;
+    const uint8_t *font;
+  };
+
+  /**
+   * @class Bar
+   * @brief A horizontal bar filled proportionally to a value between min and max.
+   *        Redraws only when the filled width changes by at least one pixel
+   */
+  class Bar : public BoundWidget {
+  public:
+    Bar(PixelView *px, Region region, BoundValue value, float min = 0, float max = 100);
+
+  protected:
+    bool sample() override;
+    void draw(U8G2 *disp) override;
+
+  private:
+    BoundValue value;
+    float min;
+    float max;
+    int filled = -1;
+  };
+
+  /**
+   * @class Sparkline
+   * @brief A small line chart of the last `region.w` samples of a value, one sample per column.
+   *        A sample is taken at most every `periodMS` ms; the region is redrawn only when it is
+   */
+  class Sparkline : public BoundWidget {
+  public:
+    /**
+     * @param min, max The value range mapped to the region's height. Pass min == max to auto-scale
+     */
+    Sparkline(PixelView *px, Region region, BoundValue value, unsigned long periodMS = 250, float min = 0,
+              float max = 0);
+
+  protected:
+    bool sample() override;
+    void draw(U8G2 *disp) override;
+
+  private:
+    BoundValue value;
+    unsigned long periodMS;
+    unsigned long lastSampleMS = 0;
+    float min;
+    float max;
+    RingBuffer<float> samples;
+  };
+
+  /**
+   * @class Chart
+   * @brief A rolling time-series chart for telemetry that is pushed in, rather than sampled.
+   *
+   * Holds the last `capacity` samples in a ring buffer. When there are more samples than pixel columns, each
+   * column shows the min..max of a bucket of samples. Buckets are aligned to the absolute sample count, so a
+   * new sample either extends the rightmost column or scrolls the chart one column left in the buffer and
+   * draws a single new column, instead of redrawing every sample. A full redraw only happens when an
+   * auto-scaled range has to grow or on invalidate(); an auto-scaled range never shrinks in between.
+   *
+   *   PixelView::Chart rssi(&pv, {0, 16, 128, 48}, 512, -100, -30);
+   *   rssi.push(WiFi.RSSI());
+   *   rssi.update();
+   */
+  class Chart : public BoundWidget {
+  public:
+    /**
+     * @param capacity Number of samples shown. Rounded up to a whole number of samples per pixel column
+     * @param min, max The value range mapped to the region's height. Pass min == max to auto-scale
+     */
+    Chart(PixelView *px, Region region, size_t capacity, float min = 0, float max = 0);
+
+    /**
+     * @brief Adds a sample. Nothing is drawn until update()
+     */
+    void push(float value);
+
+    /**
+     * @return Samples per pixel column (1 if the chart isn't decimating)
+     */
+    size_t samplesPerColumn() const { return bucketSize; }
+
+    void invalidate() override {
+      fullRedraw = true;
+      BoundWidget::invalidate();
+    }
+
+  protected:
+    bool sample() override { return false; }
+    void draw(U8G2 *disp) override;
+    void redraw() override;
+
+  private:
+    bool bucketRange(unsigned long bucket, float *lo, float *hi);
+    void drawBucket(U8G2 *disp, unsigned long bucket);
+    int toY(float v) const;
+
+    size_t bucketSize;
+    RingBuffer<float> samples; // One extra sample so the leftmost column can join its predecessor
+    unsigned long total = 0;   // Samples pushed since construction
+    float min;
+    float max;
+    float lo = 0; // Range currently drawn
+    float hi = 0;
+    bool fullRedraw = true;
+    size_t newColumns = 0; // Columns added since the last redraw
+  };
+
+  /**
+   * @class StatusIcon
+   * @brief Shows one of several icons depending on an integer state (e.g. WiFi bars, battery level).
+   *        Redraws only when the state changes
+   */
+  class StatusIcon : public BoundWidget {
+  public:
+    /**
+     * @param icons Array of XBM bitmaps, each region.w x region.h. The bound value indexes into it. With no icons
+     *              nothing is drawn
+     */
+    StatusIcon(PixelView *px, Region region, BoundValue value, const unsigned char *icons[], const size_t numIcons);
+
+  protected:
+    bool sample() override;
+    void draw(U8G2 *disp) override;
+
+  private:
+    BoundValue value;
+    const unsigned char **icons;
+    size_t numIcons;
+    int state = -1;
+  };
+
+  class Scene;
+
+  /**
+   * @class Node
+   * @brief A node of a retained-mode widget tree (see Scene): a rectangle of the screen that redraws itself only
+   *        when invalidated
+   *
+   * Subclass it and implement draw(). Call invalidate() when the node's state changes, or override sample()
+   * to detect changes the way BoundWidget does; the next Scene::render() redraws only invalidated nodes and
+   * sends the rectangle around them. Siblings must not overlap.
+   */
+  class Node {
+  public:
+    struct Size {
+      int16_t w;
+      int16_t h;
+    };
+
+    virtual ~Node() {}
+
+    /**
+     * @brief The size this node wants, at most `available`. By default it takes all of it
+     */
+    virtual Size measure(U8G2 * /*disp*/, Size available) { return available; }
+
+    /**
+     * @brief Places the node (and its children) and invalidates it
+     */
+    virtual void layout(U8G2 *disp, const Region &bounds);
+
+    /**
+     * @brief Marks the node for redrawing on the next Scene::render()
+     */
+    void invalidate();
+
+    const Region &getBounds() const { return bounds; }
+    Node *getParent() const { return parent; }
+
+  protected:
+    /**
+     * @brief Draws the node inside getBounds(). The area is already cleared and clipped to it. Children are
+     *        drawn afterwards by the Scene
+     */
+    virtual void draw(U8G2 *disp) = 0;
+
+    /**
+     * @brief Called once per Scene::render() before drawing
+     * @return true if the node changed and must be redrawn
+     */
+    virtual bool sample() { return false; }
+
+    /**
+     * @brief The node's children, for containers
+     */
+    virtual size_t childCount() const { return 0; }
+    virtual Node *child(size_t) const { return NULL; }
+
+    void adopt(Node *child) { child->parent = this; }
+
+    Region bounds = {0, 0, 0, 0};
+
+  private:
+    friend class Scene;
+    Node *parent = NULL;
+    bool dirty = true;        // This node must be redrawn
+    bool subtreeDirty = true; // This node or one below it must be redrawn
+  };
+
+  /**
+   * @class Container
+   * @brief Stacks its children vertically or horizontally. Each child gets the size it measures, the last one
+   *        gets whatever is left
+   */
+  class Container : public Node {
+  public:
+    enum class Direction { VERTICAL, HORIZONTAL };
+
+    Container(Node *children[], const size_t numChildren, Direction direction = Direction::VERTICAL, int16_t gap = 0);
+
+    Size measure(U8G2 *disp, Size available) override;
+    void layout(U8G2 *disp, const Region &bounds) override;
+
+  protected:
+    void draw(U8G2 * /*disp*/) override {}
+    size_t childCount() const override { return numChildren; }
+    Node *child(size_t i) const override { return children[i]; }
+
+  private:
+    Node **children;
+    size_t numChildren;
+    Direction direction;
+    int16_t gap;
+  };
+
+  /**
+   * @class Label
+   * @brief One line of text. setText() only invalidates the label if the text actually changed
+   */
+  class Label : public Node {
+  public:
+    enum class Align { LEFT, CENTER, RIGHT };
+
+    Label(const char *text = "", const uint8_t *font = NULL, Align align = Align::LEFT, bool inverted = false);
+
+    /**
+     * @brief Sets the text, cut to 31 bytes. NULL is the same as ""
+     */
+    void setText(const char *text);
+    const char *getText() const { return text; }
+
+    Size measure(U8G2 *disp, Size available) override;
+
+  protected:
+    void draw(U8G2 *disp) override;
+
+  private:
+    char text[32];
+    const uint8_t *font;
+    Align align;
+    bool inverted;
+  };
+
+  /**
+   * @class Scene
+   * @brief Renders a tree of Nodes, redrawing only the invalidated ones and sending the smallest rectangle
+   *        around them
+   *
+   * @code
+   * PixelView::Label title("Status", NULL, PixelView::Label::Align::CENTER, true);
+   * PixelView::Label value("--");
+   * PixelView::Node *rows[] = {&title, &value};
+   * PixelView::Container root(rows, 2);
+   * PixelView::Scene scene(&pv, &root);
+   *
+   * value.setText("42"); // Only this label is redrawn and sent
+   * scene.render();
+   * @endcode
+   */
+  class Scene {
+  public:
+    Scene(PixelView *px, Node *root);
+
+    /**
+     * @brief Lays the tree out over the whole display. Called by the first render(); call it again after
+     *        changing the tree's structure
+     */
+    void layout();
+
+    /**
+     * @brief Samples every node, then redraws the invalidated ones
+     * @param flush Send the redrawn rectangle to the display
+     * @return true if anything was redrawn
+     */
+    bool render(bool flush = true);
+
+    /**
+     * @brief The rectangle sent by the last render() that drew something
+     */
+    Region lastRegion = {0, 0, 0, 0};
+
+    /**
+     * @brief Number of nodes drawn by the last render()
+     */
+    size_t lastDrawn = 0;
+
+  private:
+    PixelView *px;
+    Node *root;
+    bool laidOut = false;
+
+    void sampleTree(Node *node);
+    void collect(Node *node, Region &area, bool &any);
+    void paint(Node *node, const Region &area, bool repaint);
+    void drawNode(Node *node);
+    void clean(Node *node);
+  };
+
   /**
    * @class menuItem
    * @brief Contains a name and a 16x16 icon
@@ -275,6 +1408,89 @@ public:
    */
   int menu(menuItem items[], const size_t numItems, int index = 0);
 
+  /**
+   * @brief Shows the entries of one menu of a MenuNode tree: like menu() if any entry has an icon, otherwise like
+   *        subMenu() with the node's label as header. LEFT goes back
+   *
+   * @param node A submenu node
+   * @param index The entry selected at first
+   * @return the selected entry's index, or -1 if LEFT was pressed
+   */
+  int menuLevel(const MenuNode &node, int index = 0);
+
+  /**
+   * @class MenuNavigator
+   * @brief Walks a constant MenuNode tree. SEL opens submenus and picks actions, LEFT goes back up
+   *
+   * The path to the current menu is kept in a fixed stack of `Depth` levels, with the selected entry of each, so
+   * going back or calling select() again returns to the same entry. Size it with menuDepth(). Submenus below
+   * `Depth` are treated as leaves.
+   *
+   * ```cpp
+   * PixelView::MenuNavigator<menuDepth(mainMenu)> nav(&pv, mainMenu);
+   * const MenuNode *picked = nav.select(); // Calls the entry's action too
+   * ```
+   */
+  template <uint8_t Depth> class MenuNavigator {
+    static_assert(Depth > 0, "the root must be a submenu");
+
+  public:
+    MenuNavigator(PixelView *pixelView, const MenuNode &root) : px(pixelView) { stack[0] = {&root, 0}; }
+
+    /**
+     * @brief Shows menus until a leaf is selected, calls its action and returns it. Returns NULL if LEFT is
+     *        pressed in the root menu
+     */
+    const MenuNode *select() {
+      while (true) {
+        Level &level = stack[depth - 1];
+        int choice = px->menuLevel(*level.node, level.index);
+        if (choice < 0) {
+          if (depth == 1) return NULL;
+          depth--;
+          continue;
+        }
+
+        level.index = choice;
+        const MenuNode &entry = level.node->children[choice];
+        if (entry.isSubmenu() && depth < Depth) {
+          // Reopening the submenu we came back from keeps its selection
+          if (stack[depth].node != &entry) stack[depth] = {&entry, 0};
+          depth++;
+          continue;
+        }
+
+        if (entry.action) entry.action();
+        return &entry;
+      }
+    }
+
+    /**
+     * @brief Goes back to the first entry of the root menu
+     */
+    void reset() {
+      depth = 1;
+      stack[0].index = 0;
+      for (uint8_t i = 1; i < Depth; i++) stack[i].node = NULL;
+    }
+
+    /**
+     * @brief The menu currently shown and how many menus deep it is (1 for the root)
+     */
+    const MenuNode &current() const { return *stack[depth - 1].node; }
+    uint8_t getDepth() const { return depth; }
+
+  private:
+    struct Level {
+      const MenuNode *node;
+      uint8_t index;
+    };
+
+    PixelView *px;
+    Level stack[Depth] = {};
+    uint8_t depth = 1;
+  };
+
   /**
    * @brief Similar to `menu` but does not have icons and also has a header
    *
@@ -295,7 +1511,18 @@ public:
    */
   int subMenu(const char *header, const String items[], const size_t numItems, int index = 0);
 
-  int carousel(const unsigned char *icons[], const size_t numItems);
+  /**
+   * @brief Big icons side by side, the selected one in the middle. LEFT and RIGHT slide to the previous or next
+   *        one (wrapping around), SEL picks it
+   *
+   * The selected icon and the two on each side are kept decoded in RAM (5 x 512 bytes for 64x64 icons), and the
+   * ones missing after a slide are decoded while waiting for input, so sliding never waits for a decode.
+   *
+   * @param icons XBM images or PackedBitmaps of iconSize x iconSize pixels, in PROGMEM
+   * @param iconSize Geometry::CAROUSEL_ICON by default: 64, or 32 on panels less than 64 pixels high
+   * @return The index of the selected icon, or -1 if there are none or the cache couldn't be allocated
+   */
+  int carousel(const unsigned char *icons[], const size_t numItems, uint8_t iconSize = Geometry::CAROUSEL_ICON);
 
   int searchList(const char *header, const char *items[], const size_t numItems, bool caseSensitive = true);
   int searchList(const char *header, const String items[], const size_t numItems, bool caseSensitive = true);
@@ -305,10 +1532,29 @@ public:
    *
    * @param icons an array of bitmaps
    * @param numItems number of bitmaps
-   * @return
+   * @return The index of the selected icon
    */
   int gridMenu(const unsigned char *icons[], const size_t numItems);
 
+  /**
+   * @brief Returns the 16x16 XBM icon of item `index`, e.g. read from a file into a buffer. Only called for the
+   *        cells being drawn. The pointer only has to stay valid until the next call. The icon cache (see
+   *        setIconCache()) keeps them by index for as long as the gridMenu() runs, so the same buffer can be reused
+   */
+  typedef std::function<const unsigned char *(size_t index)> IconSourceType;
+
+  /**
+   * @brief gridMenu() for icons that aren't all in memory
+   *
+   * Geometry::GRID_COLUMNS icons per row, scrolling by rows with a handle on the right when there are more than
+   * Geometry::GRID_ROWS. Only the visible rows are drawn, and moving without scrolling only redraws the two cells
+   * whose selection changed.
+   *
+   * @param selected The icon selected at first
+   * @return The index of the selected icon, or -1 if there are none
+   */
+  int gridMenu(IconSourceType iconAt, const size_t numItems, int selected = 0);
+
   /**
    * @brief Radio buttons!!!
    *
@@ -334,6 +1580,23 @@ public:
    */
   void checkBoxes(const char *header, checkBox items[], const size_t numItems);
 
+  /**
+   * @brief Returns the label of item `index`. The pointer only has to stay valid until the next call
+   */
+  typedef std::function<const char *(size_t index)> LabelSourceType;
+
+  /**
+   * @brief checkBoxes() for long lists: the states live in `checked`, one bit per item, and the labels are asked
+   *        for only when shown. The header shows how many items are checked
+   *
+   * UP/DOWN move, SEL toggles, RIGHT moves a page down (wrapping around) and a long SEL returns. LEFT opens a menu
+   * of bulk actions: check all, check none, invert, and check or uncheck the range from a mark set beforehand to
+   * the current item, plus jumps to the first and last item.
+   *
+   * @param checked One bit per item, changed in place. Returns at once if it couldn't be allocated
+   */
+  void checkBoxes(const char *header, BitSet &checked, LabelSourceType labelAt);
+
   /**
    * @brief Shows a list of items that you can scroll through
    *
@@ -363,7 +1626,173 @@ public:
   void listBrowser(const char *header, const unsigned char iconBitmap[], const String items[], const size_t numItems,
                    ListType displayType = ListType::NUMBER);
 
+#if defined(PIXELVIEW_LOG_FS) || defined(PIXELVIEW_LOG_POSIX)
+  /**
+   * @brief Browses a log file of any size, following lines appended to it
+   *
+   * Only the lines shown are read. The file is indexed in the background between inputs, so the first lines show
+   * at once and the header shows the progress; after that it shows the last line shown and the line count.
+   *
+   * UP/DOWN scroll a line, and a page at a time while held. LEFT/RIGHT scroll sideways through long lines. SEL
+   * returns. At the end of the log the view follows new lines, like `tail -f`; scrolling up stops following and
+   * scrolling back to the end resumes it.
+   *
+   * @param follow Start at the end of the log and follow it, instead of at its first line
+   */
+  void logViewer(const char *header, LogFile &log, bool follow = true);
+#endif
+
   void progressBar(int progress, const char *header, const unsigned char *bitmap[] = NULL);
 
+  /**
+   * @class Progress
+   * @brief progressBar() for loops that report progress far more often than the display can show it
+   *
+   * update() can be called on every chunk of a download: it only redraws when the filled width of the bar or
+   * the label changes, and then only sends the tiles of the bar or the label, not the whole screen. With
+   * `showEta` the label also holds the time left, from a smoothed transfer rate.
+   *
+   * ```cpp
+   * PixelView::Progress progress(&pv, "Updating", true);
+   * while (received < total) {
+   *   received += client.read(buffer, sizeof(buffer));
+   *   progress.update(received, total);
+   * }
+   * ```
+   */
+  class Progress {
+  public:
+    Progress(PixelView *px, const char *header, bool showEta = false);
+
+    /**
+     * @brief Reports that `done` out of `total` units (bytes, files, ...) are done. The first call draws the
+     *        whole screen
+     * @return true if anything was redrawn
+     */
+    bool update(unsigned long done, unsigned long total = 100);
+
+    /**
+     * @brief Draws and sends the whole screen again, e.g. after something else drew over it
+     */
+    void redraw();
+
+    /**
+     * @brief Units per second, smoothed over the last few seconds. 0 until known
+     */
+    float getRate() const { return rate; }
+
+    /**
+     * @brief Seconds left at the current rate, or -1 if unknown
+     */
+    long getEtaSeconds() const;
+
+    unsigned long updates = 0; // Calls to update()
+    unsigned long redraws = 0; // Updates that changed what is shown
+
+    /**
+     * @brief Shortest time between two rate samples, in ms. The ETA changes at most this often
+     */
+    unsigned long sampleMillis = 500;
+
+  private:
+    PixelView *px;
+    const char *header;
+    bool showEta;
+    bool drawn = false;
+    unsigned long done = 0;
+    unsigned long total = 100;
+    int filled = -1;
+    char label[24] = "";
+
+    float rate = 0;
+    unsigned long sampleDone = 0;
+    unsigned long sampleAt = 0;
+
+    int filledWidth() const;
+    void formatLabel(char *out, size_t size) const;
+    void sample(unsigned long now);
+
+    /**
+     * @brief Redraws rows of tiles [firstRow, lastRow] and sends them
+     */
+    void redrawRows(int firstRow, int lastRow);
+  };
+
   void progressCircle(int frame);
+
+  /**
+   * @class Spinner
+   * @brief Animates progressCircle() from a background task while the caller is stuck in a blocking call
+   *
+   * start() draws the first frame, then the task (FreeRTOS on ESP32, a thread on the host) moves the filled dot
+   * every `periodMillis` ms. Each step only redraws and sends the two dots that changed. Don't draw anything else
+   * between start() and stop(): the task owns the display meanwhile.
+   *
+   * ```cpp
+   * PixelView::Spinner spinner(&pv);
+   * spinner.start("Scanning...");
+   * int n = WiFi.scanNetworks(); // Blocks for seconds, the dots keep turning
+   * spinner.stop();
+   * ```
+   *
+   * On platforms without tasks start() returns false; call step() yourself to animate.
+   */
+  class Spinner {
+  public:
+    explicit Spinner(PixelView *px, unsigned long periodMillis = 100);
+    Spinner(const Spinner &) = delete;
+    Spinner &operator=(const Spinner &) = delete;
+    ~Spinner(); // Stops it
+
+    /**
+     * @brief Draws the whole circle, with `message` above it (displays 64 pixels high or more), and starts the task
+     * @return false if there is no background task to animate it, or it couldn't be started
+     */
+    bool start(const char *message = NULL);
+
+    /**
+     * @brief Stops the animation and returns once the task has stopped drawing. The last frame stays on screen
+     */
+    void stop();
+
+    /**
+     * @brief Moves the filled dot once and sends the two dots that changed
+     */
+    void step();
+
+    bool isRunning() const { return running; }
+
+    unsigned long periodMillis;
+    unsigned long steps = 0;
+
+  private:
+    PixelView *px;
+    const char *message = NULL;
+    int frame = 0;
+#if defined(PIXELVIEW_FLUSH_FREERTOS) || defined(PIXELVIEW_FLUSH_THREAD)
+    std::atomic<bool> running{false};  // Set by the caller, read by isRunning() from any task
+    std::atomic<bool> stopping{false}; // Set by stop(), read by the task
+#else
+    bool running = false;
+    bool stopping = false;
+#endif
+
+    void draw();
+
+    /**
+     * @brief Redraws the area of dot `dot` and sends it
+     */
+    void redrawDot(int dot);
+
+#if defined(PIXELVIEW_FLUSH_FREERTOS)
+    TaskHandle_t task = NULL;
+    SemaphoreHandle_t stopped = NULL; // Given by the task when it exits
+    static void taskMain(void *self);
+#elif defined(PIXELVIEW_FLUSH_THREAD)
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable wake;
+    void threadMain();
+#endif
+  };
 };
@@ -0,0 +1,101 @@
+// StringUtils formatters against snprintf.
+// Run with: pio test -e bench -f bench_format
+#include "StringUtils.h"
+#include <chrono>
+#include <stdio.h>
+#include <unity.h>
+
+static const int ITERATIONS = 500000;
+
+void setUp() {}
+void tearDown() {}
+
+template <typename F> static double nanosPerIteration(F body) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < ITERATIONS; i++)
+    body(i);
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / ITERATIONS;
+}
+
+// `library` is 0 when snprintf has no equivalent
+static void report(const char *name, double formatter, double library) {
+  char line[96];
+  if (library > 0)
+    snprintf(line, sizeof(line), "%-20s StringUtils %6.1f ns  snprintf %6.1f ns", name, formatter, library);
+  else
+    snprintf(line, sizeof(line), "%-20s StringUtils %6.1f ns", name, formatter);
+  TEST_MESSAGE(line);
+}
+
+static void test_unsigned_bases() {
+  char buf[StringUtils::MAX_INT_CHARS];
+  volatile char sink = 0;
+  const char *formats[] = {"%u", "%x"};
+  const unsigned int bases[] = {10, 16};
+  for (int k = 0; k < 2; k++) {
+    double formatter = nanosPerIteration([&](int i) {
+      StringUtils::appendUnsigned(buf, (unsigned int)i * 2654435761u, bases[k]);
+      sink = sink + buf[0];
+    });
+    double library = nanosPerIteration([&](int i) {
+      snprintf(buf, sizeof(buf), formats[k], (unsigned int)i * 2654435761u);
+      sink = sink + buf[0];
+    });
+    report(bases[k] == 10 ? "unsigned, base 10" : "unsigned, base 16", formatter, library);
+  }
+  double binary = nanosPerIteration([&](int i) {
+    StringUtils::appendUnsigned(buf, (unsigned int)i * 2654435761u, 2);
+    sink = sink + buf[0];
+  });
+  report("unsigned, base 2", binary, 0);
+
+  StringUtils::appendUnsigned(buf, 4294967295u);
+  TEST_ASSERT_EQUAL_STRING("4294967295", buf);
+  StringUtils::appendUnsigned(buf, 0xbeefu, 16);
+  TEST_ASSERT_EQUAL_STRING("beef", buf);
+}
+
+static void test_signed() {
+  char buf[StringUtils::MAX_INT_CHARS];
+  volatile char sink = 0;
+  double formatter = nanosPerIteration([&](int i) {
+    StringUtils::appendSigned(buf, i - ITERATIONS / 2);
+    sink = sink + buf[0];
+  });
+  double library = nanosPerIteration([&](int i) {
+    snprintf(buf, sizeof(buf), "%d", i - ITERATIONS / 2);
+    sink = sink + buf[0];
+  });
+  report("signed", formatter, library);
+
+  StringUtils::appendSigned(buf, -2147483647 - 1);
+  TEST_ASSERT_EQUAL_STRING("-2147483648", buf);
+}
+
+static void test_fixed() {
+  char buf[StringUtils::MAX_FIXED_CHARS];
+  volatile char sink = 0;
+  double formatter = nanosPerIteration([&](int i) {
+    StringUtils::appendFixed(buf, i * 0.37 - 5000);
+    sink = sink + buf[0];
+  });
+  double library = nanosPerIteration([&](int i) {
+    snprintf(buf, sizeof(buf), "%.2f", i * 0.37 - 5000);
+    sink = sink + buf[0];
+  });
+  report("fixed, 2 decimals", formatter, library);
+
+  StringUtils::appendFixed(buf, -3.14159, 3);
+  TEST_ASSERT_EQUAL_STRING("-3.142", buf);
+  StringUtils::appendFixed(buf, 9.999);
+  TEST_ASSERT_EQUAL_STRING("10.00", buf);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_unsigned_bases);
+  RUN_TEST(test_signed);
+  RUN_TEST(test_fixed);
+  return UNITY_END();
+}
@@ -0,0 +1,217 @@
+// Input-to-photon latency of the widgets on each bus preset, measured with LatencyProbe on scripted input.
+// Transfers take as long as on the real bus, so this runs for a few seconds. Run with:
+//   pio test -e bench -f bench_latency
+#include "pixelView.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <unity.h>
+
+void setUp() {}
+void tearDown() {}
+
+// One doInput() poll per character: U D L R S for the buttons, '.' for none. Widgets act on a press and then
+// wait for its release, some of them twice, so presses are followed by a few '.'
+class Script {
+public:
+  void start(const char *steps) {
+    this->steps = steps;
+    at = 0;
+  }
+
+  ActionType next() {
+    if (steps[at] == '\0') {
+      // The widget didn't return at the end of the script: hold SEL for 2 s at a time (long enough for a long
+      // press) and release it, so the run still ends
+      return overrun++ % 101 < 100 ? ActionType::SEL : ActionType::NONE;
+    }
+    switch (steps[at++]) {
+    case 'U':
+      return ActionType::UP;
+    case 'D':
+      return ActionType::DOWN;
+    case 'L':
+      return ActionType::LEFT;
+    case 'R':
+      return ActionType::RIGHT;
+    case 'S':
+      return ActionType::SEL;
+    default:
+      return ActionType::NONE;
+    }
+  }
+
+  bool finished() const { return steps[at] == '\0'; }
+
+  unsigned long overrun = 0;
+
+private:
+  const char *steps = "";
+  size_t at = 0;
+};
+
+static Script script;
+
+static void realDelay(int ms) { usleep(ms * 1000); }
+
+static void print(const char *line) { TEST_MESSAGE(line); }
+
+static const char *labels[] = {"Wi-Fi", "Bluetooth", "Display", "Sound", "Storage", "About"};
+static const size_t NUM_LABELS = sizeof(labels) / sizeof(labels[0]);
+static const unsigned char icon[32] = {0};
+static const unsigned char bigIcon[64 * 64 / 8] = {0};
+
+static PixelView::Pager::PagerActionType statusPage(U8G2 *disp, PixelView *, PixelView::Pager::Page *,
+                                                    const size_t) {
+  disp->drawStr(0, 20, "Status");
+  return PixelView::Pager::PagerActionType::CONTINUE;
+}
+
+static char logPath[] = "/tmp/bench_latencyXXXXXX";
+
+static void writeLog() {
+  int fd = mkstemp(logPath);
+  FILE *f = fdopen(fd, "w");
+  for (int i = 0; i < 500; i++)
+    fprintf(f, "%05d boot: a line long enough to scroll sideways through, line %d of the log\n", i, i);
+  fclose(f);
+}
+
+// Runs every widget through the same presses with `bus`, printing a report per widget
+static void runWidgets(const BusTiming &bus) {
+  U8G2 display;
+  PixelView pv(&display, [] { return script.next(); }, realDelay);
+  pv.setBusTiming(bus);
+  PixelView::LatencyProbe probe(&pv);
+
+  PixelView::menuItem items[NUM_LABELS];
+  for (size_t i = 0; i < NUM_LABELS; i++)
+    items[i] = {labels[i], icon};
+  script.start(".D...D...D...U...S...");
+  pv.menu(items, NUM_LABELS);
+  probe.report("menu", print);
+
+  probe.reset();
+  script.start(".D...D...D...U...S...");
+  pv.subMenu("Settings", labels, NUM_LABELS);
+  probe.report("subMenu", print);
+
+  probe.reset();
+  script.start(".D...D...U...S...");
+  pv.radioSelect("Mode", labels, NUM_LABELS);
+  probe.report("radioSelect", print);
+
+  probe.reset();
+  script.start(".D...D...D...D...U...S...");
+  pv.listBrowser("Log", NULL, labels, NUM_LABELS);
+  probe.report("listBrowser", print);
+
+  probe.reset();
+  script.start(".R...L...R...S...");
+  pv.confirmYN("Reset?");
+  probe.report("confirmYN", print);
+
+  // checkBoxes() returns on a SEL held for 1.7 s: 90 polls of 20 ms
+  static char checkBoxSteps[128];
+  memset(checkBoxSteps, 'S', sizeof(checkBoxSteps) - 1);
+  const char *presses = ".D...S...D...S...";
+  memcpy(checkBoxSteps, presses, strlen(presses));
+  checkBoxSteps[strlen(presses) + 90] = '.';
+  checkBoxSteps[strlen(presses) + 91] = '\0';
+  PixelView::checkBox boxes[] = {{"Wi-Fi", false}, {"Bluetooth", true}, {"Sound", false}, {"Storage", false}};
+  probe.reset();
+  script.start(checkBoxSteps);
+  pv.checkBoxes("Enable", boxes, 4);
+  probe.report("checkBoxes", print);
+
+  const unsigned char *icons[12];
+  for (const unsigned char *&i : icons)
+    i = icon;
+  probe.reset();
+  script.start(".R...D...R...L...U...S...");
+  pv.gridMenu(icons, 12);
+  probe.report("gridMenu", print);
+
+  probe.reset();
+  script.start(".R...D...R...L...U...S...");
+  pv.gridMenu([](size_t) { return icon; }, 12);
+  probe.report("gridStream", print);
+
+  const unsigned char *bigIcons[6];
+  for (const unsigned char *&i : bigIcons)
+    i = bigIcon;
+  probe.reset();
+  script.start(".R...R...L...S...");
+  pv.carousel(bigIcons, 6);
+  probe.report("carousel", print);
+
+  // SEL opens the action menu, whose first entry picks the item
+  probe.reset();
+  script.start(".D...D...U...S.....S...");
+  pv.searchList("Find", labels, NUM_LABELS);
+  probe.report("searchList", print);
+
+  // Types 1 and 2, then moves to the enter key at the bottom left
+  PixelView::Keyboard keyboard(&pv);
+  probe.reset();
+  script.start(".S...R...S...D...D...D...L...S...");
+  keyboard.numPad();
+  probe.report("numPad", print);
+
+  // Types q, then moves to <ok> at the bottom right
+  probe.reset();
+  script.start(".S...D...D...D...R.R.R.R.R.R.R.R.R...S...");
+  keyboard.fullKeyboard();
+  probe.report("fullKeyboard", print);
+
+  LogFile log;
+  TEST_ASSERT_TRUE(log.open(logPath));
+  probe.reset();
+  script.start(".D...D...D...U...R...L...S...");
+  pv.logViewer("Log", log, false);
+  probe.report("logViewer", print);
+
+  // Pager::poll() is called from the caller's loop, with pre-rendered neighbours
+  PixelView::Pager::Page pages[3] = {{true, statusPage, PixelView::Pager::Refresh::STATIC},
+                                     {true, statusPage, PixelView::Pager::Refresh::STATIC},
+                                     {true, statusPage, PixelView::Pager::Refresh::STATIC}};
+  PixelView::Pager pager(&pv, 3, pages);
+  TEST_ASSERT_TRUE(pager.setPrefetch(true));
+  probe.reset();
+  script.start("....R...R...L...D...U...");
+  while (!script.finished()) {
+    pager.poll();
+    realDelay(20);
+  }
+  probe.report("Pager::poll", print);
+
+  // Progress::update() isn't driven by buttons: each SEL stands for a chunk arriving, reported at once
+  PixelView::Progress progress(&pv, "Updating");
+  unsigned long done = 0;
+  probe.reset();
+  script.start("S.S.S.S.S.S.S.S.S.S.");
+  while (!script.finished()) {
+    if (pv.doInput() == ActionType::SEL) progress.update(done += 10, 100);
+  }
+  probe.report("Progress", print);
+}
+
+static void test_i2c_100k() { runWidgets(BusTiming::i2c(100000)); }
+static void test_i2c_400k() { runWidgets(BusTiming::i2c(400000)); }
+static void test_i2c_1m() { runWidgets(BusTiming::i2c(1000000)); }
+static void test_spi_8m() { runWidgets(BusTiming::spi(8000000)); }
+
+static void test_scripts_ended_the_widgets() { TEST_ASSERT_EQUAL(0, script.overrun); }
+
+int main() {
+  writeLog();
+  UNITY_BEGIN();
+  RUN_TEST(test_i2c_100k);
+  RUN_TEST(test_i2c_400k);
+  RUN_TEST(test_i2c_1m);
+  RUN_TEST(test_spi_8m);
+  RUN_TEST(test_scripts_ended_the_widgets);
+  unlink(logPath);
+  return UNITY_END();
+}
@@ -0,0 +1,56 @@
+// Frame RAM and draw time of a full buffer (_F_) against page buffers (_2_, _1_), drawing progressBar().
+// Run with: pio test -e bench -f bench_page_buffer
+#include "pixelView.h"
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include <unity.h>
+
+static const int ITERATIONS = 20000;
+
+void setUp() {}
+void tearDown() {}
+
+static ActionType noInput() { return ActionType::NONE; }
+static void noDelay(int) {}
+
+template <typename F> static double microsPerIteration(F body) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < ITERATIONS; i++)
+    body(i);
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / ITERATIONS / 1000;
+}
+
+static void report(const char *name, uint8_t bufferRows, double micros) {
+  char line[96];
+  snprintf(line, sizeof(line), "%s %4d B frame RAM, %d pass(es), %5.1f us/frame", name, U8G2::W * bufferRows,
+           U8G2::H / 8 / bufferRows, micros);
+  TEST_MESSAGE(line);
+}
+
+static void test_progress_bar() {
+  static const struct {
+    const char *name;
+    uint8_t bufferRows;
+  } modes[] = {{"_F_", U8G2::H / 8}, {"_2_", 2}, {"_1_", 1}};
+
+  uint8_t fullScreen[sizeof(U8G2::screen)];
+  for (const auto &mode : modes) {
+    U8G2 display(mode.bufferRows);
+    PixelView pv(&display, noInput, noDelay);
+    double micros = microsPerIteration([&](int i) { pv.progressBar(i % 101, "Updating"); });
+    report(mode.name, mode.bufferRows, micros);
+
+    // Whatever the buffer, the panel ends up showing the same frame
+    pv.progressBar(42, "Updating");
+    if (mode.bufferRows == U8G2::H / 8) memcpy(fullScreen, display.screen, sizeof(fullScreen));
+    else TEST_ASSERT_EQUAL_MEMORY(fullScreen, display.screen, sizeof(fullScreen));
+  }
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_progress_bar);
+  return UNITY_END();
+}
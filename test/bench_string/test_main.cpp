@@ -0,0 +1,98 @@
+// Host String (src/MyString.h) against std::string on the edits the keyboard makes to its text.
+// Run with: pio test -e bench -f bench_string
+#include "MyString.h"
+#include <chrono>
+#include <stdio.h>
+#include <string>
+#include <unity.h>
+
+static const int ITERATIONS = 200000;
+
+void setUp() {}
+void tearDown() {}
+
+template <typename F> static double nanosPerIteration(F body) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < ITERATIONS; i++)
+    body(i);
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / ITERATIONS;
+}
+
+static void report(const char *name, double string, double stdString) {
+  char line[96];
+  snprintf(line, sizeof(line), "%-28s String %6.1f ns  std::string %6.1f ns", name, string, stdString);
+  TEST_MESSAGE(line);
+}
+
+// Insert a key at the cursor, as fullKeyboard() does: substring + key + substring
+static void test_insert_at_cursor() {
+  static const char *keys[] = {"a", "b", "c", "d"};
+  volatile size_t sink = 0;
+  double string = nanosPerIteration([&](int i) {
+    String text = "hello world";
+    unsigned int cursor = i % text.length();
+    text = text.substring(0, cursor) + keys[i % 4] + text.substring(cursor);
+    sink = sink + text.length();
+  });
+  double stdString = nanosPerIteration([&](int i) {
+    std::string text = "hello world";
+    size_t cursor = i % text.length();
+    text = text.substr(0, cursor) + keys[i % 4] + text.substr(cursor);
+    sink = sink + text.length();
+  });
+  report("insert at cursor", string, stdString);
+
+  String text = "hello world";
+  text = text.substring(0, 5) + "," + text.substring(5);
+  TEST_ASSERT_EQUAL_STRING("hello, world", text.c_str());
+}
+
+// Labels built from a value, e.g. "Volume: 42%"
+static void test_number_label() {
+  volatile size_t sink = 0;
+  double string = nanosPerIteration([&](int i) {
+    String label = "Volume: ";
+    label += i % 101;
+    label += "%";
+    sink = sink + label.length();
+  });
+  double stdString = nanosPerIteration([&](int i) {
+    std::string label = "Volume: ";
+    label += std::to_string(i % 101);
+    label += "%";
+    sink = sink + label.length();
+  });
+  report("number label", string, stdString);
+
+  String label = "Volume: ";
+  label += 42;
+  TEST_ASSERT_EQUAL_STRING("Volume: 42", label.c_str());
+}
+
+// Text longer than the inline buffer, returned by value (fullKeyboard(), numPad())
+static void test_long_text_by_value() {
+  volatile size_t sink = 0;
+  auto makeString = [](int i) {
+    String text = "a long line of text that does not fit inline";
+    text += i;
+    return text;
+  };
+  auto makeStdString = [](int i) {
+    std::string text = "a long line of text that does not fit inline";
+    text += std::to_string(i);
+    return text;
+  };
+  double string = nanosPerIteration([&](int i) { sink = sink + makeString(i).length(); });
+  double stdString = nanosPerIteration([&](int i) { sink = sink + makeStdString(i).length(); });
+  report("long text returned by value", string, stdString);
+  TEST_ASSERT_EQUAL_STRING("a long line of text that does not fit inline7", makeString(7).c_str());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_insert_at_cursor);
+  RUN_TEST(test_number_label);
+  RUN_TEST(test_long_text_by_value);
+  return UNITY_END();
+}
@@ -0,0 +1,278 @@
+#pragma once
+
+// A stand-in for U8g2 on the host, for the tests and benchmarks in test/. It implements the subset PixelView
+// uses with a real 1bpp tile buffer, full or paged, and keeps what was sent in `screen`, so tests can compare
+// what reaches the panel. Text is drawn as one pixel per character; glyphs drawn one by one are kept in `glyphs`.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+#ifndef MOCK_DISPLAY_WIDTH
+#define MOCK_DISPLAY_WIDTH 128
+#define MOCK_DISPLAY_HEIGHT 64
+#endif
+
+typedef uint8_t u8g2_uint_t;
+typedef struct u8g2_struct u8g2_t;
+typedef struct {
+  void *unused;
+} u8g2_cb_t;
+typedef void (*u8g2_draw_ll_hvline_cb)(u8g2_t *u8g2, u8g2_uint_t x, u8g2_uint_t y, u8g2_uint_t len, uint8_t dir);
+
+struct u8g2_struct {
+  const u8g2_cb_t *cb;
+  u8g2_draw_ll_hvline_cb ll_hvline;
+  uint8_t *tile_buf_ptr;
+  uint8_t tile_buf_height;
+  uint8_t tile_curr_row;
+  const uint8_t *font;
+  uint8_t draw_color;
+  uint8_t bitmap_transparency;
+  u8g2_uint_t user_x0, user_x1, user_y0, user_y1;
+  uint8_t is_page_clip_window_intersection;
+};
+
+class U8G2;
+typedef struct u8x8_struct {
+  U8G2 *owner;
+} u8x8_t;
+
+inline const u8g2_cb_t *u8g2_mock_r0() {
+  static const u8g2_cb_t cb = {NULL};
+  return &cb;
+}
+inline void u8g2_ll_hvline_vertical_top_lsb(u8g2_t *, u8g2_uint_t, u8g2_uint_t, u8g2_uint_t, uint8_t) {}
+
+#define U8X8_PROGMEM
+#define U8G2_WITH_CLIP_WINDOW_SUPPORT
+#define u8x8_pgm_read(adr) (*(const uint8_t *)(adr))
+#define U8G2_BTN_INV 1
+#define U8G2_BTN_SHADOW2 2
+#define U8G2_BTN_HCENTER 4
+#define U8G2_BTN_BW1 8
+#define U8G2_R0 (u8g2_mock_r0())
+#define U8X8_PIN_NONE 255
+
+// Only their addresses are used
+static const uint8_t u8g2_font_6x12_tr[1] = {0}, u8g2_font_6x13_me[1] = {0}, u8g2_font_6x12_t_symbols[1] = {0},
+                     u8g2_font_profont12_tf[1] = {0}, u8g2_font_haxrcorp4089_tr[1] = {0},
+                     u8g2_font_helvB08_tr[1] = {0}, u8g2_font_helvR08_tr[1] = {0},
+                     u8g2_font_unifont_t_75[1] = {0}, u8g2_font_6x13_tr[1] = {0};
+
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t) { return 1; }
+  size_t write(const uint8_t *buffer, size_t size) {
+    for (size_t i = 0; i < size; i++)
+      write(buffer[i]);
+    return size;
+  }
+};
+
+class U8G2 : public Print {
+public:
+  static const int W = MOCK_DISPLAY_WIDTH;
+  static const int H = MOCK_DISPLAY_HEIGHT;
+
+  u8g2_t u8g2;
+  u8x8_t u8x8;
+  uint8_t buffer[W * H / 8];
+  uint8_t screen[W * H / 8] = {0}; // What the panel shows
+  unsigned long tilesSent = 0;
+  std::string glyphs;
+
+  /**
+   * @param bufferRows Tile rows in the buffer: H / 8 for a full buffer (_F_), 1 or 2 for a page buffer
+   */
+  explicit U8G2(uint8_t bufferRows = H / 8) {
+    u8x8.owner = this;
+    u8g2.cb = U8G2_R0;
+    u8g2.ll_hvline = u8g2_ll_hvline_vertical_top_lsb;
+    u8g2.tile_buf_ptr = buffer;
+    u8g2.tile_buf_height = bufferRows;
+    u8g2.tile_curr_row = 0;
+    u8g2.font = NULL;
+    u8g2.draw_color = 1;
+    u8g2.bitmap_transparency = 0;
+    updateClip();
+    clearBuffer();
+  }
+
+  void begin() {}
+  u8g2_t *getU8g2() { return &u8g2; }
+  u8x8_t *getU8x8() { return &u8x8; }
+
+  // Buffer
+  uint8_t *getBufferPtr() { return u8g2.tile_buf_ptr; }
+  uint8_t getBufferTileHeight() { return u8g2.tile_buf_height; }
+  uint8_t getBufferTileWidth() { return W / 8; }
+  uint8_t getBufferCurrTileRow() { return u8g2.tile_curr_row; }
+  void setBufferCurrTileRow(uint8_t row) {
+    u8g2.tile_curr_row = row;
+    updateClip();
+  }
+  void clearBuffer() {
+    for (int i = 0; i < W * u8g2.tile_buf_height; i++)
+      u8g2.tile_buf_ptr[i] = 0;
+  }
+  void sendBuffer() { sendRows(u8g2.tile_curr_row, u8g2.tile_buf_height); }
+  void firstPage() {
+    setBufferCurrTileRow(0);
+    clearBuffer();
+  }
+  uint8_t nextPage() {
+    sendRows(u8g2.tile_curr_row, u8g2.tile_buf_height);
+    int row = u8g2.tile_curr_row + u8g2.tile_buf_height;
+    if (row >= H / 8) return 0;
+    clearBuffer();
+    setBufferCurrTileRow(row);
+    return 1;
+  }
+  void updateDisplay() { sendBuffer(); }
+  void updateDisplayArea(uint8_t tx, uint8_t ty, uint8_t tw, uint8_t th) {
+    if (u8g2.tile_buf_height != H / 8) return;
+    tilesSent += tw * th;
+    for (int row = ty; row < ty + th; row++)
+      for (int x = tx * 8; x < (tx + tw) * 8; x++)
+        screen[row * W + x] = u8g2.tile_buf_ptr[row * W + x];
+  }
+
+  // Settings
+  void setFont(const uint8_t *font) { u8g2.font = font; }
+  void setFontMode(uint8_t) {}
+  void setFontPosBaseline() {}
+  void setDrawColor(uint8_t color) { u8g2.draw_color = color; }
+  uint8_t getDrawColor() { return u8g2.draw_color; }
+  void setBitmapMode(uint8_t mode) { u8g2.bitmap_transparency = mode; }
+  void setContrast(uint8_t) {}
+  void setFlipMode(uint8_t) {}
+  void setPowerSave(uint8_t) {}
+  void setCursor(int, int) {}
+  void setClipWindow(int x0, int y0, int x1, int y1) {
+    clipX0 = x0;
+    clipY0 = y0;
+    clipX1 = x1;
+    clipY1 = y1;
+    updateClip();
+  }
+  void setMaxClipWindow() { setClipWindow(0, 0, W, H); }
+
+  // Metrics: every font is 6 pixels wide and 10 high
+  int8_t getAscent() { return 8; }
+  int8_t getDescent() { return -2; }
+  int8_t getMaxCharHeight() { return 10; }
+  int8_t getMaxCharWidth() { return 6; }
+  u8g2_uint_t getUTF8Width(const char *s) { return 6 * std::char_traits<char>::length(s); }
+  u8g2_uint_t getStrWidth(const char *s) { return getUTF8Width(s); }
+  u8g2_uint_t getDisplayWidth() { return W; }
+  u8g2_uint_t getDisplayHeight() { return H; }
+
+  // Drawing
+  void drawPixel(int x, int y) {
+    if (x < clipX0 || x >= clipX1 || y < clipY0 || y >= clipY1) return;
+    int row = y / 8 - u8g2.tile_curr_row;
+    if (row < 0 || row >= u8g2.tile_buf_height) return;
+    uint8_t &b = u8g2.tile_buf_ptr[row * W + x];
+    uint8_t mask = 1 << (y & 7);
+    if (u8g2.draw_color == 0) b &= ~mask;
+    else if (u8g2.draw_color == 1) b |= mask;
+    else b ^= mask;
+  }
+  u8g2_uint_t drawUTF8(int x, int y, const char *s) {
+    int w = 0;
+    for (; *s; s++, w += 6)
+      drawPixel(x + w, y - 1);
+    return w;
+  }
+  u8g2_uint_t drawStr(int x, int y, const char *s) { return drawUTF8(x, y, s); }
+  u8g2_uint_t drawGlyph(int x, int y, uint16_t c) {
+    drawPixel(x, y);
+    glyphs += (char)c;
+    return 6;
+  }
+  void drawButtonUTF8(int x, int y, int, int, int, int, const char *s) { drawUTF8(x, y, s); }
+  void drawHLine(int x, int y, int w) {
+    for (int i = 0; i < w; i++)
+      drawPixel(x + i, y);
+  }
+  void drawVLine(int x, int y, int h) {
+    for (int i = 0; i < h; i++)
+      drawPixel(x, y + i);
+  }
+  void drawBox(int x, int y, int w, int h) {
+    for (int i = 0; i < h; i++)
+      drawHLine(x, y + i, w);
+  }
+  void drawRBox(int x, int y, int w, int h, int) { drawBox(x, y, w, h); }
+  void drawFrame(int x, int y, int w, int h) {
+    drawHLine(x, y, w);
+    drawHLine(x, y + h - 1, w);
+    drawVLine(x, y, h);
+    drawVLine(x + w - 1, y, h);
+  }
+  void drawRFrame(int x, int y, int w, int h, int) { drawFrame(x, y, w, h); }
+  void drawLine(int x0, int y0, int x1, int y1) {
+    int dx = x1 > x0 ? x1 - x0 : x0 - x1, dy = y1 > y0 ? y1 - y0 : y0 - y1, n = dx > dy ? dx : dy;
+    for (int i = 0; i <= n; i++)
+      drawPixel(x0 + (n ? (x1 - x0) * i / n : 0), y0 + (n ? (y1 - y0) * i / n : 0));
+  }
+  void drawXBMP(int x, int y, int w, int h, const uint8_t *bitmap) {
+    int rowBytes = (w + 7) / 8;
+    uint8_t color = u8g2.draw_color;
+    for (int j = 0; j < h; j++)
+      for (int i = 0; i < w; i++) {
+        if (bitmap[j * rowBytes + i / 8] & (1 << (i & 7))) {
+          drawPixel(x + i, y + j);
+        } else if (!u8g2.bitmap_transparency) {
+          u8g2.draw_color = color == 0;
+          drawPixel(x + i, y + j);
+          u8g2.draw_color = color;
+        }
+      }
+  }
+  void drawXBM(int x, int y, int w, int h, const uint8_t *bitmap) { drawXBMP(x, y, w, h, bitmap); }
+  void drawCircle(int x, int y, int) { drawPixel(x, y); }
+  void drawDisc(int x, int y, int) { drawPixel(x, y); }
+  void drawEllipse(int x, int y, int, int) { drawPixel(x, y); }
+  void drawFilledEllipse(int x, int y, int, int) { drawPixel(x, y); }
+
+private:
+  int clipX0 = 0, clipY0 = 0, clipX1 = W, clipY1 = H;
+
+  // U8g2 keeps the clip window intersected with the current page in u8g2_t, and PixelView reads it from there
+  void updateClip() {
+    int pageTop = u8g2.tile_curr_row * 8;
+    int pageBottom = pageTop + u8g2.tile_buf_height * 8;
+    if (pageBottom > H) pageBottom = H;
+    int top = clipY0 > pageTop ? clipY0 : pageTop;
+    int bottom = clipY1 < pageBottom ? clipY1 : pageBottom;
+    u8g2.is_page_clip_window_intersection = clipX0 < clipX1 && top < bottom;
+    if (u8g2.is_page_clip_window_intersection) {
+      u8g2.user_x0 = clipX0;
+      u8g2.user_x1 = clipX1;
+      u8g2.user_y0 = top;
+      u8g2.user_y1 = bottom;
+    }
+  }
+
+  void sendRows(uint8_t row, uint8_t count) {
+    for (int r = 0; r < count && row + r < H / 8; r++)
+      for (int x = 0; x < W; x++)
+        screen[(row + r) * W + x] = u8g2.tile_buf_ptr[r * W + x];
+    tilesSent += W / 8 * count;
+  }
+};
+
+struct U8G2_SH1106_128X64_NONAME_F_HW_I2C : U8G2 {
+  U8G2_SH1106_128X64_NONAME_F_HW_I2C(const void *, int) {}
+};
+
+inline void u8x8_DrawTile(u8x8_t *u8x8, uint8_t x, uint8_t y, uint8_t count, uint8_t *tiles) {
+  U8G2 *display = u8x8->owner;
+  display->tilesSent += count;
+  for (int i = 0; i < count * 8; i++)
+    display->screen[y * U8G2::W + x * 8 + i] = tiles[i];
+}
+inline void u8x8_RefreshDisplay(u8x8_t *) {}
@@ -0,0 +1,108 @@
+#include "BitSet.h"
+#include "pixelView.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <unity.h>
+#include <vector>
+
+void setUp() {}
+void tearDown() {}
+
+static ActionType noInput() { return ActionType::NONE; }
+static void noDelay(int) {}
+
+static bool matches(const BitSet &set, const std::vector<bool> &expected) {
+  size_t count = 0;
+  for (size_t i = 0; i < expected.size(); i++) {
+    if (set.test(i) != expected[i]) return false;
+    count += expected[i];
+  }
+  // The padding of the last word stays clear
+  if (expected.size() % 32 != 0 && set.data()[expected.size() / 32] >> (expected.size() % 32) != 0) return false;
+  return set.count() == count;
+}
+
+static void test_empty_and_reversed_ranges() {
+  BitSet set(100);
+  set.setRange(40, 40);
+  set.setRange(70, 10);
+  set.setRange(200, 300); // Starts past the end
+  set.setRange(150, 120);
+  TEST_ASSERT_EQUAL(0, set.count());
+  TEST_ASSERT_TRUE(matches(set, std::vector<bool>(100)));
+}
+
+static void test_range_clamped_to_size() {
+  BitSet set(70);
+  set.setRange(60, 1000);
+  std::vector<bool> expected(70);
+  for (size_t i = 60; i < 70; i++)
+    expected[i] = true;
+  TEST_ASSERT_TRUE(matches(set, expected));
+}
+
+// Random operations, checked against std::vector<bool> after each one
+static void test_against_vector_bool() {
+  srand(1);
+  for (size_t size : {1, 31, 32, 33, 64, 100, 2000}) {
+    BitSet set(size);
+    std::vector<bool> expected(size);
+    bool ok = true;
+    for (int op = 0; op < 500 && ok; op++) {
+      size_t a = rand() % (size + 40);
+      size_t b = rand() % (size + 40);
+      bool value = rand() % 2;
+      switch (rand() % 4) {
+      case 0:
+        set.setRange(a, b, value);
+        for (size_t i = a; i < b && i < size; i++)
+          expected[i] = value;
+        break;
+      case 1:
+        if (a < size) {
+          set.set(a, value);
+          expected[a] = value;
+        }
+        break;
+      case 2:
+        if (a < size) {
+          set.flip(a);
+          expected[a] = !expected[a];
+        }
+        break;
+      case 3:
+        set.flipAll();
+        expected.flip();
+        break;
+      }
+      ok = matches(set, expected);
+    }
+    TEST_ASSERT_TRUE(ok);
+  }
+}
+
+// Storage that can't be allocated leaves an empty set that's safe to use, and checkBoxes() doesn't show it
+static void test_allocation_failure() {
+  BitSet set(SIZE_MAX / 2);
+  TEST_ASSERT_FALSE(set.valid());
+  TEST_ASSERT_EQUAL(0, set.size());
+  TEST_ASSERT_EQUAL(0, set.dataWords());
+  set.setAll();
+  set.flipAll();
+  set.setRange(0, 100);
+  TEST_ASSERT_EQUAL(0, set.count());
+
+  U8G2 display;
+  PixelView pv(&display, noInput, noDelay); // Would wait for input forever if the list were shown
+  pv.checkBoxes("Channels", set, [](size_t) { return "Ch"; });
+  TEST_ASSERT_TRUE(BitSet(2000).valid());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_empty_and_reversed_ranges);
+  RUN_TEST(test_range_clamped_to_size);
+  RUN_TEST(test_against_vector_bool);
+  RUN_TEST(test_allocation_failure);
+  return UNITY_END();
+}
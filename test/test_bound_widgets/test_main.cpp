@@ -0,0 +1,41 @@
+#include "pixelView.h"
+#include <math.h>
+#include <unity.h>
+
+void setUp() {}
+void tearDown() {}
+
+static ActionType noInput() { return ActionType::NONE; }
+static void noDelay(int) {}
+
+static void test_readout_long_label_and_unprintable_values() {
+  U8G2 display;
+  PixelView pv(&display, noInput, noDelay);
+  float value = NAN;
+  PixelView::Readout readout(&pv, {0, 0, 128, 16}, &value, 2, 0, "A label much longer than the display is wide",
+                             "and an equally long unit after it");
+  TEST_ASSERT_TRUE(readout.update());
+  value = 1e30f;
+  TEST_ASSERT_TRUE(readout.update());
+  value = -INFINITY;
+  TEST_ASSERT_TRUE(readout.update());
+}
+
+static void test_status_icon_without_icons() {
+  U8G2 display;
+  PixelView pv(&display, noInput, noDelay);
+  int level = 3;
+  PixelView::StatusIcon icon(&pv, {0, 0, 16, 16}, &level, NULL, 0);
+  icon.update();
+  level = -1;
+  icon.update();
+  for (uint8_t b : display.screen)
+    TEST_ASSERT_EQUAL(0, b);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_readout_long_label_and_unprintable_values);
+  RUN_TEST(test_status_icon_without_icons);
+  return UNITY_END();
+}
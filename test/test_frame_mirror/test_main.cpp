@@ -0,0 +1,251 @@
+#include "FrameMirror.h"
+#include <stdlib.h>
+#include <string.h>
+#include <unity.h>
+#include <vector>
+
+void setUp() {}
+void tearDown() {}
+
+// Rebuilds the screen from a mirror stream the way tools/mirror.py does
+struct Decoder {
+  uint8_t width = 0, height = 0; // In tiles
+  std::vector<uint8_t> tiles;
+  std::vector<uint8_t> kinds; // 'K' or 'D' of every packet applied
+  std::vector<std::vector<uint8_t>> payloads;
+  int bad = 0;
+
+  void feed(const std::vector<uint8_t> &stream) {
+    size_t pos = 0;
+    while (pos + 5 <= stream.size()) {
+      if (stream[pos] != 0xFE || stream[pos + 1] != 'P') {
+        pos++;
+        continue;
+      }
+      size_t length = stream[pos + 3] | stream[pos + 4] << 8;
+      if (pos + 5 + length + 1 > stream.size()) break;
+      std::vector<uint8_t> payload(stream.begin() + pos + 5, stream.begin() + pos + 5 + length);
+      uint8_t sum = 0;
+      for (uint8_t b : payload)
+        sum += b;
+      uint8_t kind = stream[pos + 2];
+      if ((kind != 'K' && kind != 'D') || sum != stream[pos + 5 + length] || !apply(kind, payload)) {
+        bad++;
+        pos += 2;
+        continue;
+      }
+      kinds.push_back(kind);
+      payloads.push_back(payload);
+      pos += 5 + length + 1;
+    }
+  }
+
+  bool apply(uint8_t kind, const std::vector<uint8_t> &payload) {
+    if (payload.size() < 2) return false;
+    if (kind == 'K') {
+      width = payload[0];
+      height = payload[1];
+      tiles.assign((size_t)width * height * 8, 0);
+    } else if (payload[0] != width || payload[1] != height) {
+      return false;
+    }
+    size_t pos = 2;
+    while (pos < payload.size()) {
+      if (pos + 3 > payload.size()) return false;
+      size_t index = payload[pos] | payload[pos + 1] << 8;
+      size_t count = payload[pos + 2];
+      pos += 3;
+      for (size_t tile = index; tile < index + count; tile++) {
+        if (tile >= (size_t)width * height || pos >= payload.size()) return false;
+        uint8_t mask = payload[pos++];
+        if (mask == 0) {
+          memset(&tiles[tile * 8], payload[pos++], 8);
+          continue;
+        }
+        for (int bit = 0; bit < 8; bit++) {
+          if (mask & (1 << bit)) {
+            if (pos >= payload.size()) return false;
+            tiles[tile * 8 + bit] ^= payload[pos++];
+          }
+        }
+      }
+    }
+    return pos == payload.size();
+  }
+};
+
+static std::vector<uint8_t> stream;
+
+static FrameMirror::WriteFuncType capture() {
+  stream.clear();
+  return [](const uint8_t *data, size_t length) { stream.insert(stream.end(), data, data + length); };
+}
+
+static const uint8_t TW = 16, TH = 8; // 128x64
+static const size_t ROW_BYTES = TW * 8;
+
+static void test_fill_and_xor_tiles() {
+  FrameMirror mirror(capture());
+  TEST_ASSERT_TRUE(mirror.begin(TW, TH));
+  uint8_t frame[ROW_BYTES * TH] = {0};
+  mirror.update(frame, ROW_BYTES, 0, 0, TW, TH); // A blank keyframe
+
+  memset(frame + 8, 0xAA, 8); // Tile 1 turns solid: a fill
+  mirror.update(frame, ROW_BYTES, 1, 0, 1, 1);
+  frame[8 + 3] = 0x0F; // Then a single byte of it changes: an XOR
+  mirror.update(frame, ROW_BYTES, 1, 0, 1, 1);
+  frame[8 + 1] = 0x01; // Two bytes, but not to a solid tile
+  frame[8 + 6] = 0x02;
+  mirror.update(frame, ROW_BYTES, 1, 0, 1, 1);
+
+  Decoder decoder;
+  decoder.feed(stream);
+  TEST_ASSERT_EQUAL(0, decoder.bad);
+  TEST_ASSERT_EQUAL(4, decoder.payloads.size());
+  TEST_ASSERT_EQUAL(2, decoder.payloads[0].size()); // Nothing differs from blank
+  const uint8_t fill[] = {TW, TH, 1, 0, 1, 0x00, 0xAA};
+  const uint8_t oneByte[] = {TW, TH, 1, 0, 1, 0x08, 0xAA ^ 0x0F};
+  const uint8_t twoBytes[] = {TW, TH, 1, 0, 1, 0x42, 0xAA ^ 0x01, 0xAA ^ 0x02};
+  TEST_ASSERT_EQUAL(sizeof(fill), decoder.payloads[1].size());
+  TEST_ASSERT_EQUAL_MEMORY(fill, decoder.payloads[1].data(), sizeof(fill));
+  TEST_ASSERT_EQUAL(sizeof(oneByte), decoder.payloads[2].size());
+  TEST_ASSERT_EQUAL_MEMORY(oneByte, decoder.payloads[2].data(), sizeof(oneByte));
+  TEST_ASSERT_EQUAL(sizeof(twoBytes), decoder.payloads[3].size());
+  TEST_ASSERT_EQUAL_MEMORY(twoBytes, decoder.payloads[3].data(), sizeof(twoBytes));
+  TEST_ASSERT_EQUAL_MEMORY(frame, decoder.tiles.data(), sizeof(frame));
+}
+
+// Runs end with the row and hold at most 255 tiles: a whole screen 255 tiles wide changes in runs of 255, at
+// indices past what one byte holds
+static void test_runs_of_255_tiles() {
+  const uint8_t wide = 255, high = 3;
+  std::vector<uint8_t> frame((size_t)wide * 8 * high, 0);
+  FrameMirror mirror(capture());
+  TEST_ASSERT_TRUE(mirror.begin(wide, high));
+  mirror.update(frame.data(), wide * 8, 0, 0, wide, high);
+
+  for (size_t i = 0; i < frame.size(); i++)
+    frame[i] = (uint8_t)(i * 37 + 1);
+  mirror.update(frame.data(), wide * 8, 0, 0, wide, high);
+
+  Decoder decoder;
+  decoder.feed(stream);
+  TEST_ASSERT_EQUAL(0, decoder.bad);
+  TEST_ASSERT_EQUAL(2, decoder.kinds.size());
+  TEST_ASSERT_EQUAL_MEMORY(frame.data(), decoder.tiles.data(), frame.size());
+
+  // Three runs, one per row
+  const std::vector<uint8_t> &payload = decoder.payloads[1];
+  size_t pos = 2;
+  int runs = 0;
+  while (pos < payload.size()) {
+    TEST_ASSERT_EQUAL(runs * wide, payload[pos] | payload[pos + 1] << 8);
+    TEST_ASSERT_EQUAL(wide, payload[pos + 2]);
+    pos += 3;
+    for (int t = 0; t < wide; t++) {
+      uint8_t mask = payload[pos++];
+      pos += mask == 0 ? 1 : 0;
+      for (; mask; mask &= mask - 1)
+        pos++;
+    }
+    runs++;
+  }
+  TEST_ASSERT_EQUAL(high, runs);
+}
+
+static void test_periodic_keyframes() {
+  FrameMirror mirror(capture(), 3);
+  TEST_ASSERT_TRUE(mirror.begin(TW, TH));
+  uint8_t frame[ROW_BYTES * TH] = {0};
+  size_t lastKeyframe = 0;
+  for (int i = 0; i < 7; i++) {
+    if (i > 0 && mirror.packets % 3 == 2) lastKeyframe = stream.size();
+    frame[i * 8 + 2] = 0xFF;
+    mirror.update(frame, ROW_BYTES, i, 0, 1, 1);
+  }
+
+  Decoder decoder;
+  decoder.feed(stream);
+  TEST_ASSERT_EQUAL(0, decoder.bad);
+  const uint8_t kinds[] = {'K', 'D', 'K', 'D', 'D', 'K', 'D'};
+  TEST_ASSERT_EQUAL(sizeof(kinds), decoder.kinds.size());
+  TEST_ASSERT_EQUAL_MEMORY(kinds, decoder.kinds.data(), sizeof(kinds));
+  TEST_ASSERT_EQUAL_MEMORY(frame, decoder.tiles.data(), sizeof(frame));
+
+  // A viewer that connects at the last keyframe catches up from it
+  Decoder late;
+  late.feed(std::vector<uint8_t>(stream.begin() + lastKeyframe, stream.end()));
+  TEST_ASSERT_EQUAL(0, late.bad);
+  TEST_ASSERT_EQUAL(2, late.kinds.size());
+  TEST_ASSERT_EQUAL_MEMORY(frame, late.tiles.data(), sizeof(frame));
+}
+
+static void test_checksum() {
+  FrameMirror mirror(capture());
+  TEST_ASSERT_TRUE(mirror.begin(TW, TH));
+  uint8_t frame[ROW_BYTES * TH];
+  for (size_t i = 0; i < sizeof(frame); i++)
+    frame[i] = (uint8_t)(i * 13);
+  mirror.update(frame, ROW_BYTES, 0, 0, TW, TH);
+
+  Decoder decoder;
+  decoder.feed(stream);
+  TEST_ASSERT_EQUAL(0, decoder.bad);
+  TEST_ASSERT_EQUAL(1, decoder.kinds.size());
+
+  // Any payload byte flipped is caught
+  std::vector<uint8_t> corrupted = stream;
+  corrupted[5 + 40] ^= 0x10;
+  Decoder rejecting;
+  rejecting.feed(corrupted);
+  TEST_ASSERT_EQUAL(0, rejecting.kinds.size());
+  TEST_ASSERT_TRUE(rejecting.bad > 0);
+}
+
+// Random frames sent whole or in random regions, with noise on the line between packets: the viewer always
+// ends up with what the panel shows
+static void test_random_frames() {
+  srand(7);
+  FrameMirror mirror(capture(), 10);
+  TEST_ASSERT_TRUE(mirror.begin(TW, TH));
+  uint8_t frame[ROW_BYTES * TH] = {0};
+  uint8_t panel[ROW_BYTES * TH] = {0};
+  bool ok = true;
+
+  for (int n = 0; n < 40 && ok; n++) {
+    // Sparse changes, runs of a value, or noise
+    int style = rand() % 3;
+    for (size_t i = 0; i < sizeof(frame); i++) {
+      if (style == 0 && rand() % 20 == 0) frame[i] = rand();
+      if (style == 1 && rand() % 40 == 0) memset(frame + i / 8 * 8, rand(), 8);
+      if (style == 2) frame[i] = rand();
+    }
+    uint8_t tx = 0, ty = 0, tw = TW, th = TH;
+    if (rand() % 2) {
+      tx = rand() % TW;
+      ty = rand() % TH;
+      tw = 1 + rand() % (TW - tx);
+      th = 1 + rand() % (TH - ty);
+    }
+    for (uint8_t r = ty; r < ty + th; r++)
+      memcpy(panel + r * ROW_BYTES + tx * 8, frame + r * ROW_BYTES + tx * 8, tw * 8);
+    mirror.update(frame + ty * ROW_BYTES, ROW_BYTES, tx, ty, tw, th);
+    stream.push_back('x'); // Other output sharing the port
+
+    Decoder decoder;
+    decoder.feed(stream);
+    ok = decoder.bad == 0 && decoder.tiles.size() == sizeof(panel) &&
+         memcmp(decoder.tiles.data(), panel, sizeof(panel)) == 0;
+  }
+  TEST_ASSERT_TRUE(ok);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_fill_and_xor_tiles);
+  RUN_TEST(test_runs_of_255_tiles);
+  RUN_TEST(test_periodic_keyframes);
+  RUN_TEST(test_checksum);
+  RUN_TEST(test_random_frames);
+  return UNITY_END();
+}
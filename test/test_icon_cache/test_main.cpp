@@ -0,0 +1,60 @@
+#include "pixelView.h"
+#include <string.h>
+#include <unity.h>
+
+void setUp() {}
+void tearDown() {}
+
+static ActionType pressSelect() { return ActionType::SEL; }
+static void noDelay(int) {}
+
+// Every icon is streamed into the same buffer, as when they're read from a file
+static uint8_t streamBuffer[32];
+static int offset = 0;
+
+static const unsigned char *streamIcon(size_t index) {
+  for (int i = 0; i < 32; i++)
+    streamBuffer[i] = (uint8_t)(index * 29 + i * 7 + offset);
+  return streamBuffer;
+}
+
+// Draws the first screen of a streamed gridMenu and keeps what the panel shows
+static void drawGrid(size_t cacheSlots, uint8_t *screen) {
+  U8G2 display;
+  PixelView pv(&display, pressSelect, noDelay);
+  TEST_ASSERT_TRUE(pv.setIconCache(cacheSlots));
+  pv.gridMenu(streamIcon, 12);
+  memcpy(screen, display.screen, sizeof(display.screen));
+}
+
+static void test_streamed_icons_cached_by_index() {
+  uint8_t uncached[sizeof(U8G2::screen)], cached[sizeof(U8G2::screen)];
+  drawGrid(0, uncached);
+  drawGrid(16, cached);
+  TEST_ASSERT_EQUAL_MEMORY(uncached, cached, sizeof(uncached));
+}
+
+// A second grid with other icons at the same indices doesn't show the first one's
+static void test_streamed_icons_forgotten_between_grids() {
+  U8G2 display;
+  PixelView pv(&display, pressSelect, noDelay);
+  TEST_ASSERT_TRUE(pv.setIconCache(16));
+  offset = 0;
+  pv.gridMenu(streamIcon, 12);
+  offset = 1;
+  pv.gridMenu(streamIcon, 12);
+  uint8_t cached[sizeof(U8G2::screen)];
+  memcpy(cached, display.screen, sizeof(cached));
+
+  uint8_t uncached[sizeof(U8G2::screen)];
+  drawGrid(0, uncached);
+  offset = 0;
+  TEST_ASSERT_EQUAL_MEMORY(uncached, cached, sizeof(uncached));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_streamed_icons_cached_by_index);
+  RUN_TEST(test_streamed_icons_forgotten_between_grids);
+  return UNITY_END();
+}
@@ -0,0 +1,135 @@
+#include "LogFile.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <unistd.h>
+#include <unity.h>
+
+static char path[] = "/tmp/logfile_testXXXXXX";
+
+void setUp() {
+  int fd = mkstemp(path);
+  if (fd >= 0) close(fd);
+}
+
+void tearDown() {
+  unlink(path);
+  strcpy(path, "/tmp/logfile_testXXXXXX");
+}
+
+static void writeFile(const std::string &text, const char *mode = "w") {
+  FILE *f = fopen(path, mode);
+  fwrite(text.data(), 1, text.size(), f);
+  fclose(f);
+}
+
+static std::string lineText(LogFile &log, size_t n) {
+  LogFile::Span span = log.line(n);
+  return std::string(span.data, span.length);
+}
+
+static void test_lines_and_line_breaks() {
+  writeFile("first\r\nsecond\n\nlast");
+  LogFile log;
+  TEST_ASSERT_TRUE(log.open(path));
+  TEST_ASSERT_TRUE(log.index());
+  TEST_ASSERT_EQUAL(4, log.lines());
+  TEST_ASSERT_EQUAL_STRING("first", lineText(log, 0).c_str());
+  TEST_ASSERT_EQUAL_STRING("second", lineText(log, 1).c_str());
+  TEST_ASSERT_EQUAL_STRING("", lineText(log, 2).c_str());
+  TEST_ASSERT_EQUAL_STRING("last", lineText(log, 3).c_str());
+  TEST_ASSERT_EQUAL(0, log.line(4).length);
+}
+
+// Lines far from a checkpoint, read in any order, and in budgets that end mid-line
+static void test_stride() {
+  std::string text;
+  for (int i = 0; i < 1000; i++)
+    text += "line " + std::to_string(i) + "\n";
+  writeFile(text);
+  LogFile log(7);
+  TEST_ASSERT_TRUE(log.open(path));
+  while (!log.index(100)) {
+  }
+  TEST_ASSERT_EQUAL(1000, log.lines());
+  bool ok = true;
+  for (size_t n : {999, 0, 6, 7, 8, 500, 13, 14, 998}) {
+    ok = ok && lineText(log, n) == "line " + std::to_string(n);
+  }
+  TEST_ASSERT_TRUE(ok);
+}
+
+static void test_long_line_cut_to_window() {
+  std::string text(LogFile::WINDOW_SIZE * 3, 'x');
+  writeFile(text + "\nnext\n");
+  LogFile log(1);
+  TEST_ASSERT_TRUE(log.open(path));
+  TEST_ASSERT_TRUE(log.index());
+  TEST_ASSERT_EQUAL(2, log.lines());
+  TEST_ASSERT_EQUAL(LogFile::WINDOW_SIZE, log.line(0).length);
+  TEST_ASSERT_EQUAL_STRING("next", lineText(log, 1).c_str());
+}
+
+static void test_growth() {
+  writeFile("one\ntwo");
+  LogFile log;
+  TEST_ASSERT_TRUE(log.open(path));
+  TEST_ASSERT_TRUE(log.index());
+  TEST_ASSERT_EQUAL(2, log.lines());
+
+  writeFile(" more\nthree\n", "a");
+  TEST_ASSERT_TRUE(log.refresh());
+  TEST_ASSERT_TRUE(log.index());
+  TEST_ASSERT_EQUAL(3, log.lines());
+  TEST_ASSERT_EQUAL_STRING("two more", lineText(log, 1).c_str());
+  TEST_ASSERT_EQUAL_STRING("three", lineText(log, 2).c_str());
+  TEST_ASSERT_FALSE(log.refresh());
+}
+
+// Truncated by another process: reading before refresh() sees it doesn't fault, and after it the file is indexed
+// from scratch
+static void test_truncated_after_open() {
+  std::string text;
+  for (int i = 0; i < 200; i++)
+    text += "old line " + std::to_string(i) + "\n";
+  writeFile(text);
+  LogFile log;
+  TEST_ASSERT_TRUE(log.open(path));
+  TEST_ASSERT_TRUE(log.index());
+  TEST_ASSERT_EQUAL(200, log.lines());
+
+  TEST_ASSERT_EQUAL(0, truncate(path, 0));
+  for (size_t n = 0; n < log.lines(); n++)
+    TEST_ASSERT_EQUAL(0, log.line(n).length);
+
+  writeFile("new\n", "a");
+  TEST_ASSERT_TRUE(log.refresh());
+  TEST_ASSERT_TRUE(log.index());
+  TEST_ASSERT_EQUAL(1, log.lines());
+  TEST_ASSERT_EQUAL_STRING("new", lineText(log, 0).c_str());
+}
+
+// Truncated while it's still being indexed
+static void test_truncated_while_indexing() {
+  writeFile(std::string(10000, 'a') + "\n");
+  LogFile log;
+  TEST_ASSERT_TRUE(log.open(path));
+  TEST_ASSERT_FALSE(log.index(1000));
+  writeFile("short\n");
+  while (!log.index(1000)) {
+  }
+  TEST_ASSERT_EQUAL(1, log.lines());
+  TEST_ASSERT_EQUAL_STRING("short", lineText(log, 0).c_str());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_lines_and_line_breaks);
+  RUN_TEST(test_stride);
+  RUN_TEST(test_long_line_cut_to_window);
+  RUN_TEST(test_growth);
+  RUN_TEST(test_truncated_after_open);
+  RUN_TEST(test_truncated_while_indexing);
+  return UNITY_END();
+}
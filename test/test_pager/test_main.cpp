@@ -0,0 +1,140 @@
+#include "pixelView.h"
+#include <string.h>
+#include <unity.h>
+#include <unistd.h>
+
+void setUp() {}
+void tearDown() {}
+
+static ActionType noInput() { return ActionType::NONE; }
+static void noDelay(int) {}
+
+static PixelView::Pager::PagerActionType blankPage(U8G2 *, PixelView *, PixelView::Pager::Page *, const size_t) {
+  return PixelView::Pager::PagerActionType::CONTINUE;
+}
+
+// The mock draws one pixel per byte of text, on the row above the baseline: the bottom row for the indicator
+static int indicatorPixels(U8G2 &display) {
+  int count = 0;
+  for (int x = 0; x < U8G2::W; x++)
+    count += (display.screen[(U8G2::H / 8 - 1) * U8G2::W + x] >> 7) & 1;
+  return count;
+}
+
+static void test_dots_for_a_few_pages() {
+  U8G2 display;
+  PixelView pv(&display, noInput, noDelay);
+  PixelView::Pager::Page pages[3];
+  for (auto &page : pages)
+    page = PixelView::Pager::Page(true, blankPage, PixelView::Pager::Refresh::STATIC);
+  PixelView::Pager pager(&pv, 3, pages);
+  pager.poll();
+  TEST_ASSERT_EQUAL(3 * (sizeof("●") - 1), indicatorPixels(display));
+}
+
+static void test_numbers_when_dots_dont_fit() {
+  U8G2 display;
+  PixelView pv(&display, noInput, noDelay);
+  PixelView::Pager::Page pages[30];
+  for (auto &page : pages)
+    page = PixelView::Pager::Page(true, blankPage, PixelView::Pager::Refresh::STATIC);
+  PixelView::Pager pager(&pv, 30, pages);
+  pager.poll();
+  TEST_ASSERT_EQUAL(sizeof("1 of 30") - 1, indicatorPixels(display));
+}
+
+static void test_prefetched_frame_held_back_while_asleep() {
+  U8G2 display;
+  PixelView pv(&display, noInput, noDelay);
+  PixelView::Pager::Page pages[3];
+  for (auto &page : pages)
+    page = PixelView::Pager::Page(true, blankPage, PixelView::Pager::Refresh::STATIC);
+  PixelView::Pager pager(&pv, 3, pages);
+  TEST_ASSERT_TRUE(pager.setPrefetch(true));
+  for (int i = 0; i < 3; i++)
+    pager.poll(); // The first page, then its two neighbours off-screen
+
+  PixelView::IdleManager idle(&pv, 0, 0, 1);
+  usleep(5000);
+  unsigned long sent = display.tilesSent;
+  pages[0].enabled = false; // Shows the pre-rendered next page
+  pager.poll();
+  TEST_ASSERT_TRUE(idle.getState() == PixelView::IdleManager::State::ASLEEP);
+  TEST_ASSERT_EQUAL(sent, display.tilesSent);
+  TEST_ASSERT_EQUAL(1, idle.framesSkipped);
+}
+
+static int renders = 0;
+
+static PixelView::Pager::PagerActionType countingPage(U8G2 *, PixelView *, PixelView::Pager::Page *, const size_t) {
+  renders++;
+  return PixelView::Pager::PagerActionType::CONTINUE;
+}
+
+static void test_page_max_age_overrides_pager() {
+  U8G2 display;
+  PixelView pv(&display, noInput, noDelay);
+  PixelView::Pager::Page pages[2] = {{true, blankPage, PixelView::Pager::Refresh::STATIC},
+                                     {true, countingPage, PixelView::Pager::Refresh::STATIC, false, 1}};
+  PixelView::Pager pager(&pv, 2, pages);
+  pager.prefetchMaxAgeMS = 60000;
+  TEST_ASSERT_TRUE(pager.setPrefetch(true));
+  renders = 0;
+  pager.poll();
+  pager.poll(); // Pre-renders the second page
+  TEST_ASSERT_EQUAL(1, renders);
+
+  usleep(5000);
+  pages[0].enabled = false; // The second page's frame is older than its own 1 ms, so it's rendered again
+  pager.poll();
+  TEST_ASSERT_EQUAL(2, renders);
+}
+
+static float reading = 21.5f;
+static PixelView::Readout *readout = NULL;
+static bool readoutRedrawn = false;
+
+static PixelView::Pager::PagerActionType readoutPage(U8G2 *, PixelView *, PixelView::Pager::Page *, const size_t) {
+  readoutRedrawn = readout->update();
+  return PixelView::Pager::PagerActionType::CONTINUE;
+}
+
+// A page flushing its bound widget while it's pre-rendered draws off-screen only
+static void test_prefetch_sends_nothing() {
+  U8G2 display;
+  PixelView pv(&display, noInput, noDelay);
+  PixelView::Readout widget(&pv, {0, 16, 64, 16}, &reading, 1);
+  readout = &widget;
+  PixelView::Pager::Page pages[2] = {{true, blankPage, PixelView::Pager::Refresh::STATIC},
+                                     {true, readoutPage, PixelView::Pager::Refresh::STATIC}};
+  PixelView::Pager pager(&pv, 2, pages);
+  TEST_ASSERT_TRUE(pager.setPrefetch(true));
+  pager.poll();
+
+  uint8_t shown[sizeof(U8G2::screen)];
+  memcpy(shown, display.screen, sizeof(shown));
+  unsigned long sent = display.tilesSent;
+  PixelView::FlushStats stats = pv.stats;
+  readoutRedrawn = false;
+  pager.poll(); // Pre-renders the second page
+  TEST_ASSERT_TRUE(readoutRedrawn);
+  TEST_ASSERT_EQUAL(sent, display.tilesSent);
+  TEST_ASSERT_EQUAL_MEMORY(shown, display.screen, sizeof(shown));
+  TEST_ASSERT_EQUAL(stats.frames, pv.stats.frames);
+  TEST_ASSERT_EQUAL(stats.regions, pv.stats.regions);
+
+  pages[0].enabled = false; // Shows the pre-rendered page, readout included
+  pager.poll();
+  TEST_ASSERT_FALSE(memcmp(shown, display.screen, sizeof(shown)) == 0);
+  readout = NULL;
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_dots_for_a_few_pages);
+  RUN_TEST(test_numbers_when_dots_dont_fit);
+  RUN_TEST(test_prefetched_frame_held_back_while_asleep);
+  RUN_TEST(test_page_max_age_overrides_pager);
+  RUN_TEST(test_prefetch_sends_nothing);
+  return UNITY_END();
+}
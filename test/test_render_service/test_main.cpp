@@ -0,0 +1,153 @@
+#include "RenderService.h"
+#include "pixelView.h"
+#include <atomic>
+#include <thread>
+#include <unity.h>
+#include <vector>
+
+void setUp() {}
+void tearDown() {}
+
+static ActionType noInput() { return ActionType::NONE; }
+static void noDelay(int) {}
+
+static const int PRODUCERS = 4;
+
+static void test_queue_full() {
+  MpscQueue<int> queue(4);
+  TEST_ASSERT_EQUAL(4, queue.capacity());
+  for (int i = 0; i < 4; i++)
+    TEST_ASSERT_TRUE(queue.push(int(i)));
+  TEST_ASSERT_FALSE(queue.push(4));
+
+  int value;
+  TEST_ASSERT_TRUE(queue.pop(value));
+  TEST_ASSERT_EQUAL(0, value);
+  TEST_ASSERT_TRUE(queue.push(4));
+  for (int i = 1; i <= 4; i++) {
+    TEST_ASSERT_TRUE(queue.pop(value));
+    TEST_ASSERT_EQUAL(i, value);
+  }
+  TEST_ASSERT_TRUE(queue.empty());
+}
+
+// Every value pushed is popped exactly once, and each producer's values come out in the order it pushed them
+static void test_queue_multiple_producers() {
+  const int perProducer = 20000;
+  MpscQueue<uint32_t> queue(64);
+  std::vector<std::thread> producers;
+  for (int p = 0; p < PRODUCERS; p++) {
+    producers.emplace_back([&queue, p] {
+      for (int i = 0; i < perProducer; i++) {
+        while (!queue.push((uint32_t)p << 24 | i))
+          std::this_thread::yield();
+      }
+    });
+  }
+
+  int next[PRODUCERS] = {0};
+  int received = 0;
+  bool ordered = true;
+  while (received < PRODUCERS * perProducer) {
+    uint32_t value;
+    if (!queue.pop(value)) continue;
+    int p = value >> 24;
+    ordered = ordered && (int)(value & 0xFFFFFF) == next[p];
+    next[p]++;
+    received++;
+  }
+  for (std::thread &t : producers)
+    t.join();
+
+  TEST_ASSERT_TRUE(ordered);
+  TEST_ASSERT_TRUE(queue.empty());
+}
+
+static void test_commands_coalesced_by_key() {
+  U8G2 display;
+  PixelView pv(&display, noInput, noDelay);
+  RenderService ui(&pv, 32);
+  int runs = 0;
+
+  for (int i = 0; i <= 10; i++)
+    ui.progress(i * 10, "Downloading");
+  ui.text("first");
+  ui.text("second");
+  ui.run([&runs](PixelView &) { runs++; });
+  ui.run([&runs](PixelView &) { runs++; });
+  ui.process();
+
+  TEST_ASSERT_EQUAL(4, ui.executed); // The last progress and text, and both key 0 commands
+  TEST_ASSERT_EQUAL(11, ui.coalesced);
+  TEST_ASSERT_EQUAL(2, runs);
+  TEST_ASSERT_EQUAL(0, ui.dropped.load());
+}
+
+static void test_full_queue_drops() {
+  U8G2 display;
+  PixelView pv(&display, noInput, noDelay);
+  RenderService ui(&pv, 4);
+  for (int i = 0; i < 6; i++)
+    ui.run([](PixelView &) {});
+  TEST_ASSERT_EQUAL(2, ui.dropped.load());
+  ui.wait(); // Without begin() it processes on the caller
+  TEST_ASSERT_EQUAL(4, ui.executed);
+}
+
+static void test_null_text() {
+  U8G2 display;
+  PixelView pv(&display, noInput, noDelay);
+  RenderService ui(&pv);
+  TEST_ASSERT_TRUE(ui.progress(50, NULL));
+  ui.process();
+  TEST_ASSERT_TRUE(ui.text(NULL));
+  ui.process();
+  TEST_ASSERT_EQUAL(2, ui.executed);
+}
+
+// Producers on several threads, the service on its own: every command posted runs or is coalesced
+static void test_service_thread() {
+  U8G2 display;
+  PixelView pv(&display, noInput, noDelay);
+  RenderService ui(&pv, 16);
+  TEST_ASSERT_TRUE(ui.begin());
+
+  const int perProducer = 2000;
+  std::atomic<int> runs{0};
+  std::atomic<int> runsPosted{0};
+  std::atomic<int> accepted{0};
+  std::vector<std::thread> producers;
+  for (int p = 0; p < PRODUCERS; p++) {
+    producers.emplace_back([&, p] {
+      for (int i = 0; i < perProducer; i++) {
+        bool posted;
+        if (i % 2) {
+          posted = ui.progress(i % 101, "Working");
+        } else {
+          posted = ui.run([&runs](PixelView &) { runs++; });
+          if (posted) runsPosted++;
+        }
+        if (posted) accepted++;
+        if (p == 0 && i % 100 == 0) std::this_thread::yield();
+      }
+    });
+  }
+  for (std::thread &t : producers)
+    t.join();
+  ui.wait();
+
+  TEST_ASSERT_EQUAL(PRODUCERS * perProducer, accepted.load() + (int)ui.dropped.load());
+  TEST_ASSERT_EQUAL(accepted.load(), (int)(ui.executed + ui.coalesced));
+  TEST_ASSERT_EQUAL(runsPosted.load(), runs.load()); // Key 0 is never coalesced
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_queue_full);
+  RUN_TEST(test_queue_multiple_producers);
+  RUN_TEST(test_commands_coalesced_by_key);
+  RUN_TEST(test_full_queue_drops);
+  RUN_TEST(test_null_text);
+  RUN_TEST(test_service_thread);
+  return UNITY_END();
+}
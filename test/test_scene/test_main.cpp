@@ -0,0 +1,33 @@
+#include "pixelView.h"
+#include <unity.h>
+
+void setUp() {}
+void tearDown() {}
+
+static ActionType noInput() { return ActionType::NONE; }
+static void noDelay(int) {}
+
+static void test_label_null_text() {
+  U8G2 display;
+  PixelView pv(&display, noInput, noDelay);
+  PixelView::Label title("Status");
+  PixelView::Label value(NULL);
+  TEST_ASSERT_EQUAL_STRING("", value.getText());
+
+  PixelView::Node *rows[] = {&title, &value};
+  PixelView::Container root(rows, 2);
+  PixelView::Scene scene(&pv, &root);
+  scene.render();
+
+  value.setText("42");
+  scene.render();
+  value.setText(NULL);
+  TEST_ASSERT_EQUAL_STRING("", value.getText());
+  scene.render();
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_label_null_text);
+  return UNITY_END();
+}
@@ -0,0 +1,46 @@
+#include "pixelView.h"
+#include <chrono>
+#include <thread>
+#include <unity.h>
+
+void setUp() {}
+void tearDown() {}
+
+static ActionType noInput() { return ActionType::NONE; }
+static void noDelay(int) {}
+
+static void test_start_and_stop() {
+  U8G2 display;
+  PixelView pv(&display, noInput, noDelay);
+  PixelView::Spinner spinner(&pv, 1);
+
+  TEST_ASSERT_TRUE(spinner.start("Scanning"));
+  TEST_ASSERT_TRUE(spinner.isRunning());
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  spinner.stop();
+  TEST_ASSERT_FALSE(spinner.isRunning());
+
+  // Once stop() returns the task no longer draws
+  unsigned long steps = spinner.steps;
+  TEST_ASSERT_TRUE(steps > 0);
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  TEST_ASSERT_EQUAL(steps, spinner.steps);
+}
+
+static void test_restart() {
+  U8G2 display;
+  PixelView pv(&display, noInput, noDelay);
+  PixelView::Spinner spinner(&pv, 1);
+  for (int i = 0; i < 20; i++) {
+    TEST_ASSERT_TRUE(spinner.start());
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  }
+  // The destructor stops the last one
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_start_and_stop);
+  RUN_TEST(test_restart);
+  return UNITY_END();
+}
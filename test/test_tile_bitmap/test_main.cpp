@@ -0,0 +1,51 @@
+#include "pixelView.h"
+#include <string.h>
+#include <unity.h>
+
+void setUp() {}
+void tearDown() {}
+
+static ActionType noInput() { return ActionType::NONE; }
+static void noDelay(int) {}
+
+// 16x16 XBM with a different pattern in every row, so shifted or swapped rows show up
+static uint8_t xbm[32];
+static uint8_t tiles[32];
+
+static void makeBitmap() {
+  for (int i = 0; i < 32; i++)
+    xbm[i] = (uint8_t)(i * 37 + 11);
+  PixelView::convertXBM(16, 16, xbm, tiles);
+}
+
+// drawTileBitmap() must leave the same buffer as drawXBMP(), on a background it has to overwrite
+static void checkAt(int x, int y) {
+  U8G2 expected, actual;
+  PixelView pv(&actual, noInput, noDelay);
+  memset(expected.buffer, 0x5a, sizeof(expected.buffer));
+  memset(actual.buffer, 0x5a, sizeof(actual.buffer));
+
+  expected.drawXBMP(x, y, 16, 16, xbm);
+  TileBitmap bitmap = {16, 16, tiles};
+  pv.drawTileBitmap(x, y, bitmap);
+  TEST_ASSERT_EQUAL_MEMORY(expected.buffer, actual.buffer, sizeof(expected.buffer));
+}
+
+static void test_aligned_copy() {
+  makeBitmap();
+  checkAt(8, 16);
+  checkAt(120, 48); // Clipped on the right
+}
+
+static void test_unaligned() {
+  makeBitmap();
+  checkAt(3, 5);
+  checkAt(-4, -3);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_aligned_copy);
+  RUN_TEST(test_unaligned);
+  return UNITY_END();
+}
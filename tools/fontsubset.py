@@ -0,0 +1,249 @@
+#!/usr/bin/env python3
+"""Builds subsetted copies of the fonts PixelView uses, holding only the glyphs that are actually drawn.
+
+Some roles pull in large fonts for a handful of glyphs (the keyboard's symbol keys use 6x12_t_symbols, the Pager's
+dots use unifont_t_75). This scans the library and your sketches for the strings drawn with each role in
+FontSet (src/Fonts.h) and the keyboard/numpad layouts, then runs U8G2's bdfconv to build fonts with just those
+glyphs. It writes FontsSubset.h/.cpp next to Fonts.h, which picks them up instead of the stock fonts, and
+prints the savings per font.
+
+Text roles (title, body, small, mono) also draw strings only known at runtime (menu items, user input), so they
+keep all of printable ASCII unless listed with --literal-only.
+
+Needs a u8g2 git checkout (for the BDF sources and u8g2_fonts.c) with bdfconv built:
+    git clone https://github.com/olikraus/u8g2 && make -C u8g2/tools/font/bdfconv
+
+Usage:
+    fontsubset.py --u8g2 ~/u8g2 examples/MyApp          # scan src/ and the sketch, write src/FontsSubset.*
+    fontsubset.py --dry-run examples/MyApp              # only print the glyphs each role needs
+    fontsubset.py --u8g2 ~/u8g2 --keep dots=◆◇ sketch/  # glyphs drawn from runtime strings
+"""
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+# role: (macro, stock font, BDF file, bdfconv -b mode, is text role, glyphs always kept)
+ROLES = {
+    "title": ("PIXELVIEW_FONT_TITLE", "u8g2_font_helvB08_tr", "helvB08.bdf", 0, True, ""),
+    "body": ("PIXELVIEW_FONT_BODY", "u8g2_font_helvR08_tr", "helvR08.bdf", 0, True, ""),
+    "small": ("PIXELVIEW_FONT_SMALL", "u8g2_font_haxrcorp4089_tr", "haxrcorp4089.bdf", 0, True, ""),
+    "mono": ("PIXELVIEW_FONT_MONO", "u8g2_font_6x12_tr", "6x12.bdf", 0, True, ""),
+    "keys": ("PIXELVIEW_FONT_KEYS", "u8g2_font_6x13_me", "6x13.bdf", 2, False, " "),
+    "keySymbols": ("PIXELVIEW_FONT_KEY_SYMBOLS", "u8g2_font_6x12_t_symbols", "6x12.bdf", 0, False, " "),
+    "numpad": ("PIXELVIEW_FONT_NUMPAD", "u8g2_font_profont12_tf", "profont12.bdf", 0, False, " "),
+    "dots": ("PIXELVIEW_FONT_DOTS", "u8g2_font_unifont_t_75", "unifont.bdf", 0, False, ""),
+}
+
+# Keyboard layouts (const char *name[rows][cols] = {...}) and the role their keys are drawn with
+LAYOUTS = {"letters": "keys", "capitalLetters": "keys", "symbols1": "keys", "symbols2": "keys", "numpad": "numpad"}
+
+PRINTABLE_ASCII = set(range(32, 128))
+SOURCE_EXTENSIONS = (".h", ".hpp", ".c", ".cpp", ".ino")
+
+STRING_RE = re.compile(r'"((?:[^"\\\n]|\\.)*)"')
+SET_FONT_RE = re.compile(r"setFont\s*\(([^;]*?)\)\s*;")
+NOT_DRAWN_RE = re.compile(r"\b(?:str(?:n|case|ncase)?cmp|sizeof)\s*\([^;]*?\)")
+TOKEN_RE = re.compile(r'"(?:[^"\\\n]|\\.)*"|\'(?:[^\'\\\n]|\\.)*\'|[{};]')
+SCOPE_RE = re.compile(r"\b(?:class|struct|union|enum|namespace)\b|\bextern\s*\"C\"")
+LAYOUT_RE = re.compile(r"const\s+char\s*\*\s*(\w+)\s*\[\s*\d+\s*\]\s*\[\s*\d+\s*\]\s*=\s*\{(.*?)\};", re.S)
+ESCAPE_RE = re.compile(r"\\(u[0-9a-fA-F]{4}|U[0-9a-fA-F]{8}|x[0-9a-fA-F]+|[0-7]{1,3}|.)")
+SIMPLE_ESCAPES = {"n": "\n", "t": "\t", "r": "\r", "0": "\0", "\\": "\\", '"': '"', "'": "'"}
+
+
+def decode_literal(body):
+    """The characters of a C++ string literal's body, with escapes resolved. The source is UTF-8."""
+
+    def unescape(m):
+        e = m.group(1)
+        if e[0] in "uU":
+            return chr(int(e[1:], 16))
+        if e[0] == "x":
+            return chr(int(e[1:], 16))
+        if e[0].isdigit() and e != "0":
+            return chr(int(e, 8))
+        return SIMPLE_ESCAPES.get(e, e)
+
+    return ESCAPE_RE.sub(unescape, body)
+
+
+def roles_of(font_expr):
+    """Roles a setFont() argument may refer to (fonts.<role>, its macro or its stock font). A ternary gives two"""
+    return {role for role, (macro, stock, _, _, _, _) in ROLES.items()
+            if re.search(r"\bfonts\.%s\b" % role, font_expr) or re.search(r"\b(%s|%s)\b" % (macro, stock), font_expr)}
+
+
+def function_bodies(source):
+    """(start, end) of every function body, methods defined inside a class included. Class, struct and namespace
+    scopes are looked through, initializers (like the keyboard layouts) aren't bodies"""
+    bodies, stack, last = [], [], 0
+    for m in TOKEN_RE.finditer(source):
+        token = m.group(0)
+        if token in "{};":
+            prefix = source[last:m.start()]
+            last = m.end()
+        if token == "{":
+            if stack and stack[-1][0] != "scope":
+                kind = "nested"
+            elif SCOPE_RE.search(prefix) and "(" not in prefix:
+                kind = "scope"
+            elif prefix.rstrip().endswith("="):
+                kind = "data"
+            else:
+                kind = "body"
+            stack.append((kind, m.start()))
+        elif token == "}" and stack:
+            kind, start = stack.pop()
+            if kind == "body":
+                bodies.append((start, m.end()))
+    return bodies
+
+
+def scan(source, glyphs):
+    """Adds the glyphs drawn in one source file to glyphs[role]."""
+    source = re.sub(r"//[^\n]*|/\*.*?\*/", "", source, flags=re.S)
+    source = re.sub(r"^\s*#[^\n]*", "", source, flags=re.M)  # Preprocessor lines
+
+    # Literals between setFont(role) and the next setFont() or the end of the function are drawn with that role,
+    # except the ones only compared against or measured with sizeof
+    calls = list(SET_FONT_RE.finditer(source))
+    bodies = function_bodies(source)
+    for i, call in enumerate(calls):
+        body = next((b for b in bodies if b[0] < call.start() < b[1]), None)
+        if body is None:
+            continue
+        end = min(calls[i + 1].start(), body[1]) if i + 1 < len(calls) else body[1]
+        segment = NOT_DRAWN_RE.sub("", source[call.end():end])
+        roles = roles_of(call.group(1))
+        for literal in STRING_RE.findall(segment):
+            for role in roles:
+                glyphs[role].update(ord(c) for c in decode_literal(literal))
+
+    # Single character keys of the keyboard layouts ("<caps>" and friends are drawn as symbols, see above)
+    for name, body in LAYOUT_RE.findall(source):
+        role = LAYOUTS.get(name)
+        if role is None:
+            continue
+        for literal in STRING_RE.findall(body):
+            text = decode_literal(literal)
+            if len(text) == 1:
+                glyphs[role].add(ord(text))
+
+
+def glyph_map(codepoints):
+    """bdfconv -m argument: sorted ranges like 32-127,8592"""
+    ranges = []
+    for c in sorted(codepoints):
+        if ranges and ranges[-1][1] == c - 1:
+            ranges[-1][1] = c
+        else:
+            ranges.append([c, c])
+    return ",".join(str(a) if a == b else "%d-%d" % (a, b) for a, b in ranges)
+
+
+def stock_sizes(u8g2):
+    """Sizes of the stock fonts, from u8g2_fonts.c (csrc/ in a checkout, src/clib/ in the Arduino library)"""
+    for path in ("csrc/u8g2_fonts.c", "src/clib/u8g2_fonts.c"):
+        path = os.path.join(u8g2, path)
+        if os.path.exists(path):
+            with open(path, encoding="latin-1") as f:
+                return {m.group(1): int(m.group(2)) for m in re.finditer(r"const uint8_t (\w+)\[(\d+)\]", f.read())}
+    return {}
+
+
+def bdfconv(u8g2, bdf, mode, codepoints, name):
+    """Runs bdfconv and returns the generated C definition and its size in bytes"""
+    tool = os.path.join(u8g2, "tools/font/bdfconv/bdfconv")
+    with tempfile.TemporaryDirectory() as tmp:
+        out = os.path.join(tmp, name + ".c")
+        subprocess.run([tool, "-f", "1", "-b", str(mode), "-m", glyph_map(codepoints), "-n", name, "-o", out,
+                        os.path.join(u8g2, "tools/font/bdf", bdf)], check=True, stdout=subprocess.DEVNULL)
+        with open(out, encoding="latin-1") as f:
+            code = f.read()
+    size = re.search(r"\w+\[(\d+)\]", code)
+    return code, int(size.group(1)) if size else 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    here = os.path.dirname(os.path.abspath(__file__))
+    parser.add_argument("sources", nargs="*", help="sketch files or directories to scan, besides the library")
+    parser.add_argument("--u8g2", help="u8g2 git checkout with tools/font/bdfconv/bdfconv built")
+    parser.add_argument("--out", default=os.path.join(here, "..", "src"), help="where to write FontsSubset.h/.cpp")
+    parser.add_argument("--keep", action="append", default=[], metavar="ROLE=GLYPHS",
+                        help="also keep these glyphs, e.g. ones only drawn from runtime strings")
+    parser.add_argument("--literal-only", action="append", default=[], metavar="ROLE",
+                        help="text role that only ever draws string literals, so it doesn't need all of ASCII")
+    parser.add_argument("--dry-run", action="store_true", help="print the glyphs each role needs and stop")
+    args = parser.parse_args()
+
+    glyphs = {role: set(ord(c) for c in spec[5]) for role, spec in ROLES.items()}
+    for spec in args.keep:
+        role, _, keep = spec.partition("=")
+        if role not in ROLES:
+            parser.error("unknown role %s, expected one of %s" % (role, ", ".join(ROLES)))
+        glyphs[role].update(ord(c) for c in keep)
+    for role in args.literal_only:
+        if role not in ROLES:
+            parser.error("unknown role %s, expected one of %s" % (role, ", ".join(ROLES)))
+
+    paths = [os.path.join(here, "..", "src")] + args.sources
+    for path in paths:
+        files = [path] if os.path.isfile(path) else [os.path.join(d, f) for d, _, fs in os.walk(path) for f in fs]
+        for name in sorted(files):
+            # Skip our own output, or a second run would keep everything the first one kept
+            if name.endswith(SOURCE_EXTENSIONS) and not os.path.basename(name).startswith("FontsSubset"):
+                with open(name, encoding="utf-8", errors="replace") as f:
+                    scan(f.read(), glyphs)
+
+    for role, spec in ROLES.items():
+        if spec[4] and role not in args.literal_only:
+            glyphs[role] |= PRINTABLE_ASCII
+
+    if args.dry_run or not args.u8g2:
+        for role, spec in ROLES.items():
+            shown = "".join(chr(c) for c in sorted(glyphs[role]) if c > 32)
+            print("%-11s %-26s %3d glyphs  -m %s\n            %s" % (role, spec[1], len(glyphs[role]),
+                                                                   glyph_map(glyphs[role]), shown))
+        if not args.u8g2:
+            print("\nPass --u8g2 <u8g2 checkout> to build the fonts", file=sys.stderr)
+        return
+
+    stock = stock_sizes(args.u8g2)
+    header = ["#pragma once", "", "// Generated by tools/fontsubset.py, do not edit", "", "#include <U8g2lib.h>", ""]
+    defs = ["// Generated by tools/fontsubset.py, do not edit", "", "#include <U8g2lib.h>", ""]
+    total_before = total_after = 0
+
+    print("%-11s %-26s %8s %8s %8s  glyphs" % ("role", "stock font", "before", "after", "saved"))
+    for role, (macro, font, bdf, mode, _, _) in ROLES.items():
+        name = "pixelview_font_" + role
+        code, size = bdfconv(args.u8g2, bdf, mode, glyphs[role], name)
+        before = stock.get(font, 0)
+        if before and size >= before:
+            print("%-11s %-26s %8d %8d %8s  (kept the stock font)" % (role, font, before, size, "-"))
+            total_before += before
+            total_after += before
+            continue
+
+        header.append('extern const uint8_t %s[] U8G2_FONT_SECTION("%s");' % (name, name))
+        header.append("#define %s %s" % (macro, name))
+        defs.append(code.strip())
+        defs.append("")
+        total_before += before
+        total_after += size
+        saved = "%d" % (before - size) if before else "?"
+        print("%-11s %-26s %8s %8d %8s  %d" % (role, font, before or "?", size, saved, len(glyphs[role])))
+
+    print("%-11s %-26s %8d %8d %8d" % ("total", "", total_before, total_after, total_before - total_after))
+
+    with open(os.path.join(args.out, "FontsSubset.h"), "w") as f:
+        f.write("\n".join(header) + "\n")
+    with open(os.path.join(args.out, "FontsSubset.cpp"), "w") as f:
+        f.write("\n".join(defs))
+
+
+if __name__ == "__main__":
+    main()
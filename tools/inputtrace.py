@@ -0,0 +1,127 @@
+#!/usr/bin/env python3
+"""Converts PixelView input traces (InputRecorder, src/InputTrace.h) between the binary form and text.
+
+The text form has one transition per line: the doInput() polls and milliseconds since the previous line, then
+the new action (LEFT, RIGHT, UP, DOWN, SEL, NONE, or END for the end of the session). Lines starting with # are
+comments. Edit it to cut a session down or write one by hand, then convert it back.
+
+    2 0 NONE
+    41 690 DOWN
+    3 52 NONE
+
+Usage:
+    inputtrace.py dump session.pvi                # print as text, with totals
+    inputtrace.py pack session.txt session.pvi    # text to binary
+    inputtrace.py header session.pvi session      # binary to a C array, to replay on the device
+"""
+
+import argparse
+import sys
+
+MAGIC = b"PVI1"
+ACTIONS = ["LEFT", "RIGHT", "UP", "DOWN", "SEL", "NONE"]
+END_CODE = 0xFF
+
+
+def read_varint(data, pos):
+    value = shift = 0
+    while True:
+        if pos >= len(data):
+            raise ValueError("truncated trace")
+        byte = data[pos]
+        pos += 1
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if not byte & 0x80:
+            return value, pos
+
+
+def write_varint(value):
+    out = bytearray()
+    while True:
+        byte = value & 0x7F
+        value >>= 7
+        out.append(byte | (0x80 if value else 0))
+        if not value:
+            return bytes(out)
+
+
+def decode(data):
+    """[(polls, ms, action name)] of a binary trace"""
+    if data[:4] != MAGIC:
+        raise ValueError("not a PixelView input trace (bad magic)")
+    records, pos = [], 4
+    while pos < len(data):
+        code = data[pos]
+        polls, pos = read_varint(data, pos + 1)
+        ms, pos = read_varint(data, pos)
+        records.append((polls, ms, "END" if code == END_CODE else ACTIONS[code] if code < len(ACTIONS) else "NONE"))
+    return records
+
+
+def encode(records):
+    out = bytearray(MAGIC)
+    for polls, ms, action in records:
+        out.append(END_CODE if action == "END" else ACTIONS.index(action))
+        out += write_varint(polls) + write_varint(ms)
+    return bytes(out)
+
+
+def parse_text(text):
+    records = []
+    for number, line in enumerate(text.splitlines(), 1):
+        line = line.split("#", 1)[0].strip()
+        if not line:
+            continue
+        fields = line.split()
+        if len(fields) != 3 or fields[2] not in ACTIONS + ["END"]:
+            raise ValueError("line %d: expected '<polls> <ms> <action>', got %r" % (number, line))
+        records.append((int(fields[0]), int(fields[1]), fields[2]))
+    return records
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = parser.add_subparsers(dest="command", required=True)
+    dump = sub.add_parser("dump", help="print a binary trace as text")
+    dump.add_argument("trace")
+    pack = sub.add_parser("pack", help="convert a text trace to binary")
+    pack.add_argument("text")
+    pack.add_argument("trace")
+    header = sub.add_parser("header", help="print a binary trace as a C array")
+    header.add_argument("trace")
+    header.add_argument("name")
+    args = parser.parse_args()
+
+    try:
+        if args.command == "pack":
+            with open(args.text) as f:
+                data = encode(parse_text(f.read()))
+            with open(args.trace, "wb") as f:
+                f.write(data)
+            return
+
+        with open(args.trace, "rb") as f:
+            data = f.read()
+        records = decode(data)
+    except ValueError as e:
+        sys.exit("%s: %s" % (getattr(args, "text", None) or args.trace, e))
+
+    if args.command == "dump":
+        print("# polls ms action")
+        for polls, ms, action in records:
+            print("%d %d %s" % (polls, ms, action))
+        presses = sum(1 for _, _, action in records if action not in ("NONE", "END"))
+        print("# %d transitions, %d presses, %d polls, %.1f s, %d bytes" % (
+            sum(1 for r in records if r[2] != "END"), presses, sum(r[0] for r in records),
+            sum(r[1] for r in records) / 1000, len(data)))
+    else:
+        print("// %d bytes, generated by tools/inputtrace.py" % len(data))
+        print("static const uint8_t %s[] = {" % args.name)
+        for i in range(0, len(data), 16):
+            print("    " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+        print("};")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,167 @@
+#!/usr/bin/env python3
+"""Shows what a PixelView display shows, from the stream a FrameMirror (src/FrameMirror.h) sends.
+
+Reads from a serial port, a pipe, a file or stdin, rebuilds the frames and draws them in the terminal with
+half block characters (two pixel rows per line). Bytes that aren't part of a packet, like Serial.print() output
+sharing the port, are skipped. A packet that fails its checksum is dropped; the screen may then be wrong until
+the next keyframe.
+
+Usage:
+    mirror.py /dev/ttyUSB0 --baud 921600      # live view of a device
+    ./host_app | mirror.py -                  # a host build writing the stream to stdout
+    mirror.py capture.bin --pbm frames/       # also save every frame as a PBM image
+    mirror.py capture.bin --quiet --stats     # just print the packet and byte counts
+"""
+
+import argparse
+import os
+import sys
+
+MARKER = b"\xfeP"
+
+
+class Screen:
+    def __init__(self):
+        self.width = self.height = 0  # in tiles
+        self.tiles = bytearray()
+
+    def apply(self, kind, payload):
+        """Applies a packet payload. Returns False if it doesn't make sense"""
+        if len(payload) < 2:
+            return False
+        width, height = payload[0], payload[1]
+        if kind == ord("K") or (width, height) != (self.width, self.height):
+            if kind != ord("K") and self.width:
+                return False  # A delta for another display size, wait for a keyframe
+            self.width, self.height = width, height
+            self.tiles = bytearray(width * height * 8)
+
+        pos = 2
+        while pos < len(payload):
+            if pos + 3 > len(payload):
+                return False
+            index = payload[pos] | payload[pos + 1] << 8
+            count = payload[pos + 2]
+            pos += 3
+            for tile in range(index, index + count):
+                if tile >= width * height or pos >= len(payload):
+                    return False
+                base = tile * 8
+                mask = payload[pos]
+                pos += 1
+                if mask == 0:
+                    self.tiles[base:base + 8] = bytes([payload[pos]]) * 8
+                    pos += 1
+                    continue
+                for bit in range(8):
+                    if mask & (1 << bit):
+                        self.tiles[base + bit] ^= payload[pos]
+                        pos += 1
+        return pos == len(payload)
+
+    def pixel(self, x, y):
+        return self.tiles[(y // 8) * self.width * 8 + x] >> (y % 8) & 1
+
+    def render(self):
+        """The frame as text, two rows per line"""
+        chars = {(0, 0): " ", (1, 0): "▀", (0, 1): "▄", (1, 1): "█"}
+        lines = []
+        for y in range(0, self.height * 8, 2):
+            lines.append("".join(chars[self.pixel(x, y), self.pixel(x, y + 1)] for x in range(self.width * 8)))
+        return "\n".join(lines)
+
+    def pbm(self):
+        w, h = self.width * 8, self.height * 8
+        rows = ["".join(str(self.pixel(x, y)) for x in range(w)) for y in range(h)]
+        return ("P1\n%d %d\n" % (w, h) + "\n".join(rows) + "\n").encode()
+
+
+def packets(stream, stats):
+    """Yields (kind, payload) of every well formed packet in the stream"""
+    buffer = bytearray()
+    while True:
+        chunk = os.read(stream.fileno(), 4096)
+        if not chunk:
+            return
+        buffer += chunk
+        while True:
+            start = buffer.find(MARKER)
+            if start < 0:
+                stats["skipped"] += max(0, len(buffer) - 1)
+                del buffer[:-1]
+                break
+            stats["skipped"] += start
+            del buffer[:start]
+            if len(buffer) < 5:
+                break
+            length = buffer[3] | buffer[4] << 8
+            if len(buffer) < 5 + length + 1:
+                break
+            payload = bytes(buffer[5:5 + length])
+            if buffer[2] not in b"KD" or sum(payload) & 0xFF != buffer[5 + length]:
+                stats["bad"] += 1
+                del buffer[:2]  # Look for the next marker
+                continue
+            stats["packets"] += 1
+            stats["bytes"] += 6 + length
+            kind = buffer[2]
+            del buffer[:6 + length]
+            yield kind, payload
+
+
+def open_source(path, baud):
+    if path == "-":
+        return sys.stdin.buffer
+    f = open(path, "rb", buffering=0)
+    if f.isatty():
+        import termios
+        import tty
+        tty.setraw(f.fileno())
+        attrs = termios.tcgetattr(f.fileno())
+        speed = getattr(termios, "B%d" % baud, None)
+        if speed is None:
+            sys.exit("unsupported baud rate %d" % baud)
+        attrs[4] = attrs[5] = speed
+        termios.tcsetattr(f.fileno(), termios.TCSANOW, attrs)
+    return f
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("source", help="serial port, file, or - for stdin")
+    parser.add_argument("--baud", type=int, default=115200, help="for serial ports")
+    parser.add_argument("--pbm", metavar="DIR", help="save every frame as DIR/frame_NNNNN.pbm")
+    parser.add_argument("--quiet", action="store_true", help="don't draw the frames")
+    parser.add_argument("--stats", action="store_true", help="print packet and byte counts at the end")
+    args = parser.parse_args()
+
+    screen = Screen()
+    stats = {"packets": 0, "bytes": 0, "bad": 0, "skipped": 0}
+    frame = 0
+    if args.pbm:
+        os.makedirs(args.pbm, exist_ok=True)
+
+    try:
+        for kind, payload in packets(open_source(args.source, args.baud), stats):
+            if not screen.apply(kind, payload):
+                stats["bad"] += 1
+                continue
+            frame += 1
+            if args.pbm:
+                with open(os.path.join(args.pbm, "frame_%05d.pbm" % frame), "wb") as f:
+                    f.write(screen.pbm())
+            if not args.quiet:
+                sys.stdout.write("\x1b[H\x1b[2J" + screen.render() + "\n")
+                sys.stdout.write("frame %d, %d bytes\n" % (frame, 6 + len(payload)))
+                sys.stdout.flush()
+    except KeyboardInterrupt:
+        pass
+
+    if args.stats:
+        print("%d packets, %d bytes (%.1f per packet), %d bad, %d other bytes skipped" % (
+            stats["packets"], stats["bytes"], stats["bytes"] / max(1, stats["packets"]), stats["bad"],
+            stats["skipped"]))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,162 @@
+#!/usr/bin/env python3
+"""Converts XBM bitmaps into PixelView's TileBitmap or PackedBitmap format.
+
+The SSD1306/SH1106 controllers (and U8G2's full buffer) store 8 vertical pixels per byte, in rows of 8 pixel
+high tiles. Bitmaps stored that way can be copied into the buffer a byte at a time instead of being drawn pixel by
+pixel like XBM.
+
+With --pack the tiles are also run-length encoded (src/PackedBitmap.h), which typically makes icons 2-4 times
+smaller. The packed arrays keep the original names and can replace the XBM arrays as they are: menus, gridMenu(),
+listBrowser(), StatusIcon and carousel() recognise them.
+
+Usage:
+    xbm2tiles.py icon.xbm [more.xbm ...]            # .xbm files, size read from the #defines
+    xbm2tiles.py icons.h --size name=16x16 ...      # C arrays, like the ones exported by most image editors
+    xbm2tiles.py icons.h --pack > icons_packed.h    # compressed, drop-in replacements for the XBM arrays
+
+Prints the converted arrays as C++ to stdout.
+"""
+
+import argparse
+import re
+import sys
+
+ARRAY_RE = re.compile(r"(?:static\s+)?(?:const\s+)?(?:unsigned\s+)?char\s+(\w+)\s*\[\s*\]\s*(?:U8X8_PROGMEM\s*|PROGMEM\s*)?=\s*\{([^}]*)\}", re.S)
+DEFINE_RE = re.compile(r"#define\s+(\w+)_(width|height)\s+(\d+)")
+
+
+def xbm_to_tiles(width, height, xbm):
+    """XBM rows are LSB-first bytes, left to right. Tiles are LSB-top bytes, one per column per 8 rows."""
+    row_bytes = (width + 7) // 8
+    if len(xbm) < row_bytes * height:
+        raise ValueError("expected %d bytes, got %d" % (row_bytes * height, len(xbm)))
+
+    tiles = []
+    for tile_row in range((height + 7) // 8):
+        for x in range(width):
+            byte = 0
+            for bit in range(8):
+                y = tile_row * 8 + bit
+                if y < height and xbm[y * row_bytes + x // 8] & (1 << (x % 8)):
+                    byte |= 1 << bit
+            tiles.append(byte)
+    return tiles
+
+
+PACKED_MAGIC = [0xF7, ord("P"), ord("V"), ord("Z")]
+
+
+def pack(tiles):
+    """PackBits: 0x00..0x7F is followed by n + 1 literal bytes, 0x80..0xFF repeats the next byte n - 0x80 + 3 times"""
+    out, literals, i = [], [], 0
+
+    def flush():
+        for start in range(0, len(literals), 128):
+            chunk = literals[start:start + 128]
+            out.append(len(chunk) - 1)
+            out.extend(chunk)
+        del literals[:]
+
+    while i < len(tiles):
+        run = 1
+        while i + run < len(tiles) and tiles[i + run] == tiles[i] and run < 130:
+            run += 1
+        if run >= 3:
+            flush()
+            out += [0x80 + run - 3, tiles[i]]
+            i += run
+        else:
+            literals.append(tiles[i])
+            i += 1
+    flush()
+    return out
+
+
+def unpack(data):
+    """The inverse of pack(), to check it"""
+    out, i = [], 0
+    while i < len(data):
+        code = data[i]
+        if code & 0x80:
+            out += [data[i + 1]] * (code - 0x80 + 3)
+            i += 2
+        else:
+            out += data[i + 1:i + code + 2]
+            i += code + 2
+    return out
+
+
+def emit_packed(name, width, height, xbm, tiles, out):
+    packed = pack(tiles)
+    assert unpack(packed) == tiles
+    data = PACKED_MAGIC + [width, height] + packed
+    if len(data) >= len(xbm):
+        # Small or busy icons don't shrink: keep the XBM, which is drawn the same way
+        out.write("// %s: %dx%d, %d bytes (XBM, packing doesn't make it smaller)\n" % (name, width, height, len(xbm)))
+        data = xbm
+    else:
+        out.write("// %s: %dx%d, %d bytes packed (%d as XBM)\n" % (name, width, height, len(data), len(xbm)))
+    out.write("static const unsigned char %s[] U8X8_PROGMEM = {\n" % name)
+    for i in range(0, len(data), 16):
+        out.write("    " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",\n")
+    out.write("};\n\n")
+    return len(data)
+
+
+def emit(name, width, height, tiles, out):
+    out.write("// %s: %dx%d, %d bytes\n" % (name, width, height, len(tiles)))
+    out.write("static const unsigned char %s_tiles[] U8X8_PROGMEM = {\n" % name)
+    for i in range(0, len(tiles), 16):
+        out.write("    " + ", ".join("0x%02x" % b for b in tiles[i:i + 16]) + ",\n")
+    out.write("};\n")
+    out.write("static const TileBitmap %s = {%d, %d, %s_tiles};\n\n" % (name, width, height, name))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("files", nargs="+")
+    parser.add_argument("--size", action="append", default=[], metavar="NAME=WxH",
+                        help="size of an array that has no _width/_height #defines")
+    parser.add_argument("--pack", action="store_true", help="run-length encode the bitmaps (PackedBitmap)")
+    args = parser.parse_args()
+
+    sizes = {}
+    for spec in args.size:
+        name, _, size = spec.partition("=")
+        w, _, h = size.partition("x")
+        sizes[name] = (int(w), int(h))
+
+    out = sys.stdout
+    total_xbm = total_packed = 0
+    for path in args.files:
+        with open(path) as f:
+            source = f.read()
+
+        for name, kind, value in DEFINE_RE.findall(source):
+            w, h = sizes.get(name, (0, 0))
+            sizes[name] = (int(value), h) if kind == "width" else (w, int(value))
+
+        for name, body in ARRAY_RE.findall(source):
+            base = re.sub(r"_bits$", "", name)
+            size = sizes.get(name) or sizes.get(base)
+            if size is None or 0 in size:
+                sys.stderr.write("%s: skipping %s, pass --size %s=WxH\n" % (path, name, name))
+                continue
+            xbm = [int(v, 0) for v in re.findall(r"0x[0-9a-fA-F]+|\d+", body)]
+            if xbm[:4] == PACKED_MAGIC:
+                sys.stderr.write("%s: %s starts like a PackedBitmap and would be drawn as one\n" % (path, name))
+            tiles = xbm_to_tiles(size[0], size[1], xbm)
+            if args.pack:
+                xbm = xbm[:(size[0] + 7) // 8 * size[1]]
+                total_xbm += len(xbm)
+                total_packed += emit_packed(name, size[0], size[1], xbm, tiles, out)
+            else:
+                emit(base, size[0], size[1], tiles, out)
+
+    if args.pack and total_xbm:
+        sys.stderr.write("%d bytes as XBM, %d packed (%.0f%%)\n" % (total_xbm, total_packed,
+                                                                  100.0 * total_packed / total_xbm))
+
+
+if __name__ == "__main__":
+    main()